@@ -0,0 +1,76 @@
+#include "SuffixTree.h"
+#include "BenchUtil.h"
+#include <cstdio>
+#include <random>
+
+/**
+ * Benchmark de find_approximate (Hamming y distancia de edición).
+ *
+ * Patrones sacados del corpus con algunos errores agregados (lecturas con
+ * ruido). Para cada largo de patrón y cada k reporta el tiempo por consulta
+ * y las apariciones promedio; el costo crece con k (se podan menos ramas)
+ * y, en Edit, con las palabras de 64 bits que ocupa la columna.
+ *
+ * Uso: bench_approximate [documentos] [largo_documento] [consultas]
+ */
+
+using aed::structure::SuffixTree;
+using namespace aed::bench;
+
+// Copia de un substring del corpus con `errors` sustituciones, inserciones o borrados
+static std::string noisy_read(const std::vector<std::string>& corpus, std::size_t len,
+                              int errors, std::mt19937& rng) {
+    const std::string& doc = corpus[rng() % corpus.size()];
+    std::string read = doc.substr(rng() % (doc.size() - len), len);
+    for (int e = 0; e < errors; ++e) {
+        std::size_t at = rng() % read.size();
+        switch (rng() % 3) {
+            case 0: read[at] = "ACGT"[rng() % 4]; break;
+            case 1: read.insert(read.begin() + at, "ACGT"[rng() % 4]); break;
+            default: read.erase(read.begin() + at); break;
+        }
+    }
+    return read;
+}
+
+int main(int argc, char** argv) {
+    std::size_t docs    = arg_or(argc, argv, 1, 200);
+    std::size_t doc_len = arg_or(argc, argv, 2, 5000);
+    std::size_t queries = arg_or(argc, argv, 3, 200);
+
+    auto corpus = dna_corpus(docs, doc_len);
+    std::vector<std::string_view> views(corpus.begin(), corpus.end());
+    SuffixTree st;
+    st.add_strings(views);
+    std::printf("corpus %zu docs x %zu chars, %zu consultas por fila\n", docs, doc_len, queries);
+    std::printf("%8s %4s %6s %14s %12s\n", "modelo", "k", "largo", "us/consulta", "apariciones");
+
+    for (auto model : {SuffixTree::ErrorModel::Hamming, SuffixTree::ErrorModel::Edit}) {
+        bool hamming = model == SuffixTree::ErrorModel::Hamming;
+        for (std::size_t len : {16u, 32u, 64u, 100u}) {
+            for (int k : {0, 1, 2, 3, 4}) {
+                std::mt19937 rng(static_cast<unsigned>(len * 10 + k));
+                std::vector<std::string> patterns;
+                for (std::size_t q = 0; q < queries; ++q) {
+                    patterns.push_back(hamming ? noisy_read(corpus, len, 0, rng) : noisy_read(corpus, len, k, rng));
+                    if (hamming) {
+                        for (int e = 0; e < k; ++e) {
+                            patterns.back()[rng() % len] = "ACGT"[rng() % 4];
+                        }
+                    }
+                }
+
+                std::size_t found = 0;
+                Timer t;
+                for (const auto& p : patterns) {
+                    found += st.find_approximate(p, k, model).size();
+                }
+                double ms = t.elapsed_ms();
+                std::printf("%8s %4d %6zu %14.1f %12.2f\n", hamming ? "hamming" : "edit", k, len,
+                            ms * 1000.0 / queries, static_cast<double>(found) / queries);
+                std::fflush(stdout);
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+#ifndef AED_BENCH_UTIL
+#define AED_BENCH_UTIL
+
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace aed::bench {
+
+
+/**
+ * Cronometro simple en milisegundos.
+ */
+class Timer {
+public:
+    Timer() : start(std::chrono::steady_clock::now()) {}
+
+    void reset() {
+        start = std::chrono::steady_clock::now();
+    }
+
+    double elapsed_ms() const {
+        auto d = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::milli>(d).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start;
+};
+
+
+/**
+ * Texto pseudoaleatorio reproducible sobre el alfabeto dado.
+ */
+inline std::string random_text(std::size_t n, std::string_view alphabet, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<std::size_t> pick(0, alphabet.size() - 1);
+    std::string s(n, '\0');
+    for (auto& c : s) {
+        c = alphabet[pick(rng)];
+    }
+    return s;
+}
+
+/**
+ * Corpus de `docs` documentos de `doc_len` caracteres (alfabeto ADN).
+ */
+inline std::vector<std::string> dna_corpus(std::size_t docs, std::size_t doc_len, unsigned seed = 42) {
+    std::vector<std::string> corpus;
+    corpus.reserve(docs);
+    for (std::size_t i = 0; i < docs; ++i) {
+        corpus.push_back(random_text(doc_len, "ACGT", seed + static_cast<unsigned>(i)));
+    }
+    return corpus;
+}
+
+/**
+ * Lee el argumento posicional `idx` como entero, o devuelve `fallback`.
+ */
+inline std::size_t arg_or(int argc, char** argv, int idx, std::size_t fallback) {
+    if (idx < argc) {
+        return static_cast<std::size_t>(std::strtoull(argv[idx], nullptr, 10));
+    }
+    return fallback;
+}
+
+
+} // namespace aed::bench
+
+
+#endif // AED_BENCH_UTIL
@@ -0,0 +1,55 @@
+#include "SuffixTree.h"
+#include "BenchUtil.h"
+
+/**
+ * Benchmark de insercion de un corpus con colores calculados al final:
+ *  - add_string uno por uno (colores al dia en cada insercion)
+ *  - add_strings sobre un arbol con colores invalidados (una sola pasada)
+ *  - add_strings sobre un arbol nuevo (colores al dia en cada insercion)
+ *
+ * Uso: bench_bulk_insert [documentos] [largo_documento] [repeticiones]
+ */
+
+using aed::structure::SuffixTree;
+using namespace aed::bench;
+
+int main(int argc, char** argv) {
+    std::size_t docs    = arg_or(argc, argv, 1, 2000);
+    std::size_t doc_len = arg_or(argc, argv, 2, 500);
+    std::size_t reps    = arg_or(argc, argv, 3, 5);
+
+    auto corpus = dna_corpus(docs, doc_len);
+    std::vector<std::string_view> views(corpus.begin(), corpus.end());
+
+    double single = 0, bulk_pass = 0, bulk = 0;
+    for (std::size_t r = 0; r < reps; ++r) {
+        {
+            SuffixTree st;
+            Timer t;
+            for (const auto& s : corpus) {
+                st.add_string(s);
+            }
+            st.compute_colors();
+            single += t.elapsed_ms();
+        }
+        {
+            SuffixTree st;
+            st.colors_computed = false;
+            Timer t;
+            st.add_strings(views);
+            bulk_pass += t.elapsed_ms();
+        }
+        {
+            SuffixTree st;
+            Timer t;
+            st.add_strings(views);
+            bulk += t.elapsed_ms();
+        }
+    }
+
+    std::printf("corpus: %zu docs x %zu chars, %zu repeticiones\n", docs, doc_len, reps);
+    std::printf("add_string x N:           %10.2f ms (promedio)\n", single / reps);
+    std::printf("add_strings (una pasada): %10.2f ms (promedio)\n", bulk_pass / reps);
+    std::printf("add_strings (al dia):     %10.2f ms (promedio)\n", bulk / reps);
+    return 0;
+}
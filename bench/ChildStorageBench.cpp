@@ -0,0 +1,87 @@
+#include "SuffixTree.h"
+#include "BenchUtil.h"
+
+/**
+ * Benchmark de la politica de hijos por nodo.
+ *
+ * Se compila dos veces: bench_child_storage (CompactChildren) y
+ * bench_child_storage_hash (AED_ST_HASH_CHILDREN, unordered_map por nodo).
+ * Reporta memoria por nodo (sizeof de hojas e internos + memoria dinamica
+ * de los hijos) y
+ * throughput de is_substring sobre patrones presentes y aleatorios.
+ *
+ * Uso: bench_child_storage [documentos] [largo_documento] [consultas] [largo_patron]
+ */
+
+using aed::structure::SuffixTree;
+using namespace aed::bench;
+
+int main(int argc, char** argv) {
+    std::size_t docs    = arg_or(argc, argv, 1, 32);
+    std::size_t doc_len = arg_or(argc, argv, 2, 20000);
+    std::size_t queries = arg_or(argc, argv, 3, 1000000);
+    std::size_t pat_len = arg_or(argc, argv, 4, 12);
+
+#ifdef AED_ST_HASH_CHILDREN
+    const char* mode = "HashChildren (unordered_map)";
+#else
+    const char* mode = "CompactChildren (arreglo en linea + tabla directa)";
+#endif
+
+    auto corpus = dna_corpus(docs, doc_len);
+    SuffixTree st;
+
+    Timer t;
+    for (const auto& s : corpus) {
+        st.add_string(s);
+    }
+    double build_ms = t.elapsed_ms();
+
+    // Memoria: recorrido explicito de todos los nodos
+    std::size_t nodes = 0, leaves = 0, heap = 0;
+    std::vector<const SuffixTree::Node*> stack{&st.tree.root};
+    while (!stack.empty()) {
+        const SuffixTree::Node* n = stack.back();
+        stack.pop_back();
+        ++nodes;
+        leaves += n->leaf;
+        heap += n->children().heap_bytes();
+        for (auto&& e : n->children()) {
+            stack.push_back(e.second.tgt);
+        }
+    }
+
+    // Patrones: la mitad extraidos del corpus, la mitad aleatorios
+    std::vector<std::string> patterns;
+    patterns.reserve(queries);
+    std::mt19937 rng(7);
+    for (std::size_t i = 0; i < queries; ++i) {
+        if (i % 2 == 0) {
+            const auto& doc = corpus[rng() % corpus.size()];
+            patterns.push_back(doc.substr(rng() % (doc.size() - pat_len), pat_len));
+        } else {
+            patterns.push_back(random_text(pat_len, "ACGT", static_cast<unsigned>(i)));
+        }
+    }
+
+    t.reset();
+    std::size_t hits = 0;
+    for (const auto& p : patterns) {
+        hits += st.is_substring(p);
+    }
+    double query_ms = t.elapsed_ms();
+
+    std::printf("politica: %s\n", mode);
+    std::printf("corpus: %zu docs x %zu chars\n", docs, doc_len);
+    std::printf("construccion: %.2f ms\n", build_ms);
+    std::size_t fixed = leaves * sizeof(SuffixTree::Node) + (nodes - leaves) * sizeof(SuffixTree::InnerNode);
+    std::printf("nodos: %zu (%zu hojas)  sizeof hoja: %zu B  sizeof interno: %zu B\n",
+                nodes, leaves, sizeof(SuffixTree::Node), sizeof(SuffixTree::InnerNode));
+    std::printf("en linea: %.1f B/nodo  hijos (heap): %.1f B/nodo  total: %.1f B/nodo\n",
+                static_cast<double>(fixed) / nodes,
+                static_cast<double>(heap) / nodes,
+                static_cast<double>(fixed + heap) / nodes);
+    std::printf("consultas: %zu (largo %zu), %zu aciertos, %.2f ms, %.2f Mq/s\n",
+                queries, pat_len, hits, query_ms, queries / query_ms / 1000.0);
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include "SuffixTree.h"
+#include "BenchUtil.h"
+#include <thread>
+
+/**
+ * Benchmark de consultas concurrentes sobre un arbol congelado (freeze).
+ *
+ * Todos los hilos consultan el mismo `const SuffixTree&` sin locks
+ * (is_substring, is_suffix y count); cada hilo toma un rango de los
+ * patrones. Con consultas de solo lectura el rendimiento deberia escalar
+ * linealmente con los hilos hasta la cantidad de nucleos.
+ *
+ * Uso: bench_concurrent_query [documentos] [largo_documento] [consultas] [max_hilos]
+ */
+
+using aed::structure::SuffixTree;
+using namespace aed::bench;
+
+int main(int argc, char** argv) {
+    std::size_t docs        = arg_or(argc, argv, 1, 2000);
+    std::size_t doc_len     = arg_or(argc, argv, 2, 500);
+    std::size_t queries     = arg_or(argc, argv, 3, 1000000);
+    std::size_t max_threads = arg_or(argc, argv, 4, std::max(1u, std::thread::hardware_concurrency()));
+
+    auto corpus = dna_corpus(docs, doc_len);
+    std::vector<std::string_view> views(corpus.begin(), corpus.end());
+
+    SuffixTree st;
+    st.add_strings(views);
+    st.freeze();
+    const SuffixTree& frozen = st;
+
+    std::mt19937 rng(11);
+    std::vector<std::string> patterns;
+    patterns.reserve(queries);
+    for (std::size_t q = 0; q < queries; ++q) {
+        const std::string& doc = corpus[rng() % docs];
+        std::size_t len = 4 + rng() % 12;
+        patterns.push_back(q % 2 == 0 ? doc.substr(rng() % (doc_len - len + 1), len)
+                                      : random_text(len, "ACGT", static_cast<unsigned>(q)));
+    }
+
+    std::printf("corpus: %zu docs x %zu chars, %zu consultas (nucleos: %u)\n",
+                docs, doc_len, queries, std::thread::hardware_concurrency());
+    std::printf("%6s %12s %14s %10s\n", "hilos", "ms", "Mconsultas/s", "escala");
+
+    double base = 0;
+    std::size_t expected = 0;
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        std::vector<std::size_t> hits(threads, 0);
+        std::vector<std::thread> workers;
+
+        Timer t;
+        for (std::size_t k = 0; k < threads; ++k) {
+            workers.emplace_back([&, k] {
+                std::size_t local = 0;
+                for (std::size_t q = queries * k / threads; q < queries * (k + 1) / threads; ++q) {
+                    local += frozen.is_substring(patterns[q]);
+                    local += frozen.is_suffix(patterns[q]);
+                    local += static_cast<std::size_t>(frozen.count(patterns[q]) > 1);
+                }
+                hits[k] = local;
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+        double ms = t.elapsed_ms();
+
+        std::size_t total = 0;
+        for (std::size_t h : hits) {
+            total += h;
+        }
+        if (threads == 1) {
+            base = ms;
+            expected = total;
+        } else if (total != expected) {
+            std::printf("error: %zu hilos dieron %zu aciertos, 1 hilo %zu\n", threads, total, expected);
+            return 1;
+        }
+        std::printf("%6zu %12.2f %14.2f %9.2fx\n", threads, ms, queries / ms / 1000.0, base / ms);
+    }
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include "SuffixTree.h"
+#include "TreeTraversal.h"
+#include "BenchUtil.h"
+
+/**
+ * Benchmark de recorridos sobre arboles degenerados (muy profundos).
+ *
+ * Con "aaaa..." la profundidad del arbol es el largo del string: las
+ * versiones recursivas de compute_colors_dfs / get_all_strings_dfs
+ * desbordaban la pila a partir de unos cientos de miles de caracteres.
+ * Aqui se mide el recorrido con pila explicita (DepthFirst).
+ *
+ * Uso: bench_deep_tree [largo] [repeticiones]
+ */
+
+using aed::structure::SuffixTree;
+using aed::structure::DepthFirst;
+using namespace aed::bench;
+
+using Node = SuffixTree::Node;
+using Transition = SuffixTree::Transition;
+
+static void run_case(const char* name, const std::string& input, std::size_t reps) {
+    SuffixTree st;
+
+    Timer t;
+    st.add_string(input);
+    double build = t.elapsed_ms();
+
+    // Profundidad maxima y cantidad de nodos con un recorrido simple
+    std::size_t nodes = 0, depth = 0, max_depth = 0;
+    DepthFirst<Node> dfs;
+    t.reset();
+    dfs.run(&st.tree.root,
+        [&](Node*, Transition*) {
+            ++nodes;
+            max_depth = std::max(max_depth, ++depth);
+            return true;
+        },
+        [&](Node*, Transition*) { --depth; });
+    double walk = t.elapsed_ms();
+
+    double colors = 0;
+    for (std::size_t r = 0; r < reps; ++r) {
+        st.colors_computed = false;
+        t.reset();
+        st.compute_colors();
+        colors += t.elapsed_ms();
+    }
+
+    t.reset();
+    auto groups = st.get_all_strings(&st.tree.root);
+    double all = t.elapsed_ms();
+
+    std::printf("%-10s n=%zu nodos=%zu profundidad=%zu\n", name, input.size(), nodes, max_depth);
+    std::printf("  construccion:      %10.2f ms\n", build);
+    std::printf("  recorrido simple:  %10.2f ms\n", walk);
+    std::printf("  compute_colors:    %10.2f ms (promedio de %zu)\n", colors / reps, reps);
+    std::printf("  get_all_strings:   %10.2f ms (%zu grupos)\n", all, groups.size());
+}
+
+int main(int argc, char** argv) {
+    std::size_t n    = arg_or(argc, argv, 1, 1000000);
+    std::size_t reps = arg_or(argc, argv, 2, 5);
+
+    run_case("a^n", std::string(n, 'a'), reps);
+
+    std::string periodic;
+    periodic.reserve(n);
+    while (periodic.size() < n) {
+        periodic += "ACGT";
+    }
+    periodic.resize(n);
+    run_case("(ACGT)^k", periodic, reps);
+    return 0;
+}
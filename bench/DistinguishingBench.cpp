@@ -0,0 +1,63 @@
+#include "SuffixTree.h"
+#include "SuffixArrayIndex.h"
+#include "BenchUtil.h"
+#include <cstdio>
+
+/**
+ * Benchmark de distinguishing_substrings contra el camino anterior
+ * (get_all_strings desde la raíz, que copia el camino de cada nodo) y
+ * contra SuffixArrayIndex::distinguishing_substrings.
+ *
+ * get_all_strings es cuadrático en el largo de los documentos, así que se
+ * corre solo mientras el corpus es chico.
+ *
+ * Uso: bench_distinguishing [documentos] [largo_documento]
+ */
+
+using aed::structure::SuffixTree;
+using aed::structure::SuffixArrayIndex;
+using namespace aed::bench;
+
+static void run(std::size_t docs, std::size_t doc_len) {
+    auto corpus = dna_corpus(docs, doc_len);
+    std::vector<std::string_view> views(corpus.begin(), corpus.end());
+
+    SuffixTree st;
+    st.add_strings(views);
+    st.freeze();
+    const SuffixTree& frozen = st;
+
+    std::printf("corpus %zu docs x %zu chars\n", docs, doc_len);
+
+    Timer t;
+    auto dsus = frozen.distinguishing_substrings();
+    std::printf("  distinguishing_substrings: %10.2f ms (%zu triples)\n", t.elapsed_ms(), dsus.size());
+
+    SuffixArrayIndex sa;
+    for (const auto& s : corpus) {
+        sa.add_string(s);
+    }
+    sa.build();
+    t.reset();
+    auto sa_dsus = sa.distinguishing_substrings();
+    std::printf("  SuffixArrayIndex:          %10.2f ms (%zu triples)\n", t.elapsed_ms(), sa_dsus.size());
+
+    if (docs * doc_len <= 200000) {
+        t.reset();
+        auto all = frozen.get_all_strings(&st.tree.root);
+        std::size_t strings = 0;
+        for (const auto& group : all) {
+            strings += group.second.size();
+        }
+        std::printf("  get_all_strings:           %10.2f ms (%zu strings)\n", t.elapsed_ms(), strings);
+    }
+}
+
+int main(int argc, char** argv) {
+    std::size_t docs    = arg_or(argc, argv, 1, 200);
+    std::size_t doc_len = arg_or(argc, argv, 2, 500);
+
+    run(docs, doc_len);
+    run(docs * 10, doc_len);
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include "SuffixTree.h"
+#include "BenchUtil.h"
+
+/**
+ * Benchmark de find_all con patrones de muchas apariciones.
+ *
+ * Patrones cortos sobre ADN aparecen miles de veces: find_all baja al
+ * locus una vez y recorre sus hojas (O(m + occ)), contra un escaneo
+ * ingenuo de cada documento con std::string::find (O(n) por consulta).
+ * count() responde lo mismo en O(m) con los conteos precalculados.
+ *
+ * Uso: bench_find_all [documentos] [largo_documento] [consultas]
+ */
+
+using aed::structure::SuffixTree;
+using aed::structure::Occurrence;
+using namespace aed::bench;
+
+int main(int argc, char** argv) {
+    std::size_t docs    = arg_or(argc, argv, 1, 1000);
+    std::size_t doc_len = arg_or(argc, argv, 2, 500);
+    std::size_t queries = arg_or(argc, argv, 3, 200);
+
+    auto corpus = dna_corpus(docs, doc_len);
+    std::vector<std::string_view> views(corpus.begin(), corpus.end());
+
+    SuffixTree st;
+    st.add_strings(views);
+    st.compute_counts();
+
+    std::printf("corpus: %zu docs x %zu chars, %zu consultas por largo\n", docs, doc_len, queries);
+    std::printf("%6s %12s %14s %14s %14s\n", "largo", "occ/consulta", "find_all ms", "count ms", "escaneo ms");
+
+    for (std::size_t m : {2, 4, 6, 8}) {
+        std::vector<std::string> patterns;
+        for (std::size_t q = 0; q < queries; ++q) {
+            patterns.push_back(random_text(m, "ACGT", 1000 + static_cast<unsigned>(q)));
+        }
+
+        std::size_t tree_occ = 0;
+        Timer t;
+        for (const auto& p : patterns) {
+            st.find_all(p, [&](const Occurrence&) { ++tree_occ; });
+        }
+        double tree_ms = t.elapsed_ms();
+
+        std::size_t counted = 0;
+        t.reset();
+        for (const auto& p : patterns) {
+            counted += static_cast<std::size_t>(st.count(p));
+        }
+        double count_ms = t.elapsed_ms();
+
+        std::size_t scan_occ = 0;
+        t.reset();
+        for (const auto& p : patterns) {
+            for (const auto& doc : corpus) {
+                for (auto at = doc.find(p); at != std::string::npos; at = doc.find(p, at + 1)) {
+                    ++scan_occ;
+                }
+            }
+        }
+        double scan_ms = t.elapsed_ms();
+
+        if (tree_occ != scan_occ or counted != scan_occ) {
+            std::printf("error: find_all %zu, count %zu, escaneo %zu\n", tree_occ, counted, scan_occ);
+            return 1;
+        }
+        std::printf("%6zu %12zu %14.2f %14.2f %14.2f\n", m, tree_occ / queries, tree_ms, count_ms, scan_ms);
+    }
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include "SuffixTree.h"
+#include "BenchUtil.h"
+#include <cstdio>
+#include <random>
+
+/**
+ * Benchmark de matching_statistics contra is_substring por posición.
+ *
+ * Indexa un genoma de referencia y compara una variante suya (con
+ * mutaciones puntuales cada `gap` caracteres en promedio). Con variantes
+ * parecidas los prefijos coincidentes son largos y la versión por
+ * posición (extender mientras is_substring) se vuelve cuadrática; por eso
+ * solo se corre sobre los primeros caracteres de la consulta.
+ *
+ * Uso: bench_matching_statistics [largo_referencia] [largo_consulta] [gap]
+ */
+
+using aed::structure::SuffixTree;
+using namespace aed::bench;
+
+int main(int argc, char** argv) {
+    std::size_t ref_len   = arg_or(argc, argv, 1, 2000000);
+    std::size_t query_len = arg_or(argc, argv, 2, 1000000);
+    std::size_t gap       = arg_or(argc, argv, 3, 200);
+
+    std::string reference = random_text(ref_len, "ACGT", 1);
+    std::string query = reference.substr(0, std::min(query_len, ref_len));
+    std::mt19937 rng(3);
+    for (auto& c : query) {
+        if (rng() % gap == 0) {
+            c = "ACGT"[rng() % 4];
+        }
+    }
+
+    Timer t;
+    SuffixTree st;
+    st.add_string(reference);
+    std::printf("referencia %zu, consulta %zu (mutacion cada ~%zu)\n", reference.size(), query.size(), gap);
+    std::printf("  construccion:           %10.2f ms\n", t.elapsed_ms());
+
+    std::vector<SuffixTree::Index> ms(query.size());
+    t.reset();
+    st.matching_statistics(query, ms);
+    double linear_ms = t.elapsed_ms();
+    double sum = 0;
+    for (auto len : ms) {
+        sum += len;
+    }
+    std::printf("  matching_statistics:    %10.2f ms (%.1f ns/pos, largo medio %.1f)\n",
+                linear_ms, linear_ms * 1e6 / query.size(), sum / query.size());
+
+    std::size_t prefix = std::min<std::size_t>(query.size(), 20000);
+    std::string_view q(query);
+    t.reset();
+    std::size_t mismatches = 0;
+    for (std::size_t j = 0; j < prefix; ++j) {
+        std::size_t len = 0;
+        while (j + len < q.size() and st.is_substring(q.substr(j, len + 1))) {
+            ++len;
+        }
+        mismatches += len != static_cast<std::size_t>(ms[j]);
+    }
+    double naive_ms = t.elapsed_ms();
+    std::printf("  is_substring por pos.:  %10.2f ms (%.1f ns/pos, primeras %zu, %zu diferencias)\n",
+                naive_ms, naive_ms * 1e6 / prefix, prefix, mismatches);
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include "SuffixTree.h"
+#include "BenchUtil.h"
+
+/**
+ * Benchmark de construccion y destruccion del GST.
+ *
+ * Se compila dos veces: bench_node_arena (nodos en bloques de la arena) y
+ * bench_node_arena_heap (AED_ST_HEAP_NODES, un new/delete por nodo, como
+ * antes de la arena). Comparar la salida de ambos.
+ *
+ * Uso: bench_node_arena [documentos] [largo_documento] [repeticiones]
+ */
+
+using aed::structure::SuffixTree;
+using namespace aed::bench;
+
+int main(int argc, char** argv) {
+    std::size_t docs    = arg_or(argc, argv, 1, 32);
+    std::size_t doc_len = arg_or(argc, argv, 2, 20000);
+    std::size_t reps    = arg_or(argc, argv, 3, 5);
+
+#ifdef AED_ST_HEAP_NODES
+    const char* mode = "heap (new/delete)";
+#else
+    const char* mode = "arena";
+#endif
+
+    auto corpus = dna_corpus(docs, doc_len);
+
+    double build_total = 0, destroy_total = 0;
+    std::size_t nodes = 0, slabs = 0;
+
+    for (std::size_t r = 0; r < reps; ++r) {
+        auto st = std::make_unique<SuffixTree>();
+
+        Timer t;
+        for (const auto& s : corpus) {
+            st->add_string(s);
+        }
+        build_total += t.elapsed_ms();
+
+        nodes = st->tree.arena.size();
+        slabs = st->tree.arena.slab_count();
+
+        t.reset();
+        st.reset();
+        destroy_total += t.elapsed_ms();
+    }
+
+    std::printf("modo: %s\n", mode);
+    std::printf("corpus: %zu docs x %zu chars, %zu repeticiones\n", docs, doc_len, reps);
+    std::printf("nodos: %zu  bloques: %zu\n", nodes, slabs);
+    std::printf("construccion: %10.2f ms (promedio)\n", build_total / reps);
+    std::printf("destruccion:  %10.2f ms (promedio)\n", destroy_total / reps);
+    return 0;
+}
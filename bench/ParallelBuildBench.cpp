@@ -0,0 +1,72 @@
+#include "SuffixTree.h"
+#include "BenchUtil.h"
+#include <thread>
+
+/**
+ * Benchmark de escalado de add_strings_parallel segun cantidad de hilos.
+ *
+ * La fila "1" es la construccion secuencial (add_strings). Para cada
+ * cantidad de hilos se verifica que el arbol tenga la misma cantidad de
+ * nodos y hojas que el secuencial, que la arena no guarde mas nodos que
+ * los del arbol y que todos los documentos sean substrings.
+ *
+ * Uso: bench_parallel_build [documentos] [largo_documento] [max_hilos]
+ */
+
+using aed::structure::SuffixTree;
+using namespace aed::bench;
+
+// Nodos alcanzables desde root (sin contarla) y cuantos son hojas
+static std::pair<std::size_t, std::size_t> count_nodes(SuffixTree& st) {
+    std::size_t nodes = 0, leaves = 0;
+    std::vector<const SuffixTree::Node*> stack{&st.tree.root};
+    while (!stack.empty()) {
+        const SuffixTree::Node* n = stack.back();
+        stack.pop_back();
+        nodes += n != &st.tree.root;
+        leaves += n->leaf;
+        for (auto&& e : n->children()) {
+            stack.push_back(e.second.tgt);
+        }
+    }
+    return {nodes, leaves};
+}
+
+int main(int argc, char** argv) {
+    std::size_t docs        = arg_or(argc, argv, 1, 256);
+    std::size_t doc_len     = arg_or(argc, argv, 2, 4000);
+    std::size_t max_threads = arg_or(argc, argv, 3, std::max(1u, std::thread::hardware_concurrency()));
+
+    auto corpus = dna_corpus(docs, doc_len);
+    std::vector<std::string_view> views(corpus.begin(), corpus.end());
+
+    std::printf("corpus: %zu docs x %zu chars\n", docs, doc_len);
+    std::printf("%6s %12s %9s %10s %10s\n", "hilos", "ms", "speedup", "nodos", "hojas");
+
+    double base_ms = 0;
+    std::size_t base_nodes = 0, base_leaves = 0;
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        SuffixTree st;
+        Timer t;
+        if (threads == 1) {
+            st.add_strings(views);
+        } else {
+            st.add_strings_parallel(views, static_cast<unsigned>(threads));
+        }
+        double ms = t.elapsed_ms();
+
+        auto [nodes, leaves] = count_nodes(st);
+        if (threads == 1) {
+            base_ms = ms;
+            base_nodes = nodes;
+            base_leaves = leaves;
+        }
+        bool ok = nodes == base_nodes and leaves == base_leaves and st.tree.arena.size() == nodes;
+        for (const auto& s : corpus) {
+            ok = ok and st.is_substring(s);
+        }
+
+        std::printf("%6zu %12.2f %8.2fx %10zu %10zu%s\n", threads, ms, base_ms / ms, nodes, leaves, ok ? "" : "  ERROR");
+    }
+    return 0;
+}
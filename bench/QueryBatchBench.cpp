@@ -0,0 +1,65 @@
+#include "SuffixTree.h"
+#include "BenchUtil.h"
+#include <memory>
+
+/**
+ * Benchmark de query_batch contra un ciclo de is_substring.
+ *
+ * Mitad de los patrones se toman del corpus (aciertos) y mitad son
+ * aleatorios (casi todos fallan a pocos caracteres). Se mide el
+ * rendimiento en consultas por segundo.
+ *
+ * Uso: bench_query_batch [documentos] [largo_documento] [consultas] [largo_patron]
+ */
+
+using aed::structure::SuffixTree;
+using namespace aed::bench;
+
+int main(int argc, char** argv) {
+    std::size_t docs    = arg_or(argc, argv, 1, 2000);
+    std::size_t doc_len = arg_or(argc, argv, 2, 500);
+    std::size_t queries = arg_or(argc, argv, 3, 1000000);
+    std::size_t pat_len = arg_or(argc, argv, 4, 12);
+
+    auto corpus = dna_corpus(docs, doc_len);
+    std::vector<std::string_view> views(corpus.begin(), corpus.end());
+
+    SuffixTree st;
+    st.add_strings(views);
+
+    std::mt19937 rng(7);
+    std::vector<std::string> patterns;
+    patterns.reserve(queries);
+    for (std::size_t q = 0; q < queries; ++q) {
+        if (q % 2 == 0) {
+            const std::string& doc = corpus[rng() % docs];
+            patterns.push_back(doc.substr(rng() % (doc_len - pat_len + 1), pat_len));
+        } else {
+            patterns.push_back(random_text(pat_len, "ACGT", static_cast<unsigned>(q)));
+        }
+    }
+    std::vector<std::string_view> pattern_views(patterns.begin(), patterns.end());
+
+    Timer t;
+    std::size_t loop_hits = 0;
+    for (const auto& p : patterns) {
+        loop_hits += st.is_substring(p);
+    }
+    double loop_ms = t.elapsed_ms();
+
+    std::unique_ptr<bool[]> found(new bool[queries]);
+    t.reset();
+    std::size_t batch_hits = st.query_batch(pattern_views, std::span<bool>(found.get(), queries));
+    double batch_ms = t.elapsed_ms();
+
+    if (loop_hits != batch_hits) {
+        std::printf("error: is_substring %zu aciertos, query_batch %zu\n", loop_hits, batch_hits);
+        return 1;
+    }
+
+    std::printf("corpus: %zu docs x %zu chars, %zu consultas de largo %zu (%zu aciertos)\n",
+                docs, doc_len, queries, pat_len, loop_hits);
+    std::printf("is_substring x N: %10.2f ms  %8.2f Mconsultas/s\n", loop_ms, queries / loop_ms / 1000.0);
+    std::printf("query_batch:      %10.2f ms  %8.2f Mconsultas/s\n", batch_ms, queries / batch_ms / 1000.0);
+    return 0;
+}
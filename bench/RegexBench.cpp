@@ -0,0 +1,68 @@
+#include "SuffixTree.h"
+#include "RegexNfa.h"
+#include "BenchUtil.h"
+#include <cstdio>
+
+/**
+ * Benchmark de find_regex contra recorrer todo el texto con el mismo
+ * RegexNfa (un intento desde cada posición, que es lo que hacía el
+ * post-filtrado).
+ *
+ * Uso: bench_regex [documentos] [largo_documento] [repeticiones]
+ */
+
+using aed::structure::SuffixTree;
+using aed::structure::RegexNfa;
+using namespace aed::bench;
+
+// Match más corto desde cada posición de cada documento
+static std::size_t scan(const std::vector<std::string>& corpus, const RegexNfa& nfa) {
+    std::size_t found = 0;
+    for (const auto& doc : corpus) {
+        for (std::size_t start = 0; start < doc.size(); ++start) {
+            RegexNfa::Mask active = nfa.start();
+            for (std::size_t i = start; i < doc.size() and active != 0; ++i) {
+                active = nfa.step(active, doc[i]);
+                if (nfa.accepts(active)) {
+                    ++found;
+                    break;
+                }
+            }
+        }
+    }
+    return found;
+}
+
+int main(int argc, char** argv) {
+    std::size_t docs    = arg_or(argc, argv, 1, 200);
+    std::size_t doc_len = arg_or(argc, argv, 2, 5000);
+    std::size_t reps    = arg_or(argc, argv, 3, 20);
+
+    auto corpus = dna_corpus(docs, doc_len);
+    std::vector<std::string_view> views(corpus.begin(), corpus.end());
+    SuffixTree st;
+    st.add_strings(views);
+    st.freeze();
+
+    std::printf("corpus %zu docs x %zu chars\n", docs, doc_len);
+    std::printf("%-22s %12s %12s %12s\n", "expresion", "arbol ms", "escaneo ms", "apariciones");
+    for (const char* regex : {"ACGTAC", "AC?GT", "[AG]TT.*CA", "GA.{2,5}TC", "[AG][CT]{3}A.{0,4}GGT", "ACGT{2,4}A*C"}) {
+        RegexNfa nfa;
+        nfa.compile(regex);
+
+        std::size_t found = 0;
+        Timer t;
+        for (std::size_t r = 0; r < reps; ++r) {
+            found = st.find_regex(regex).size();
+        }
+        double tree_ms = t.elapsed_ms() / reps;
+
+        t.reset();
+        std::size_t scanned = scan(corpus, nfa);
+        double scan_ms = t.elapsed_ms();
+
+        std::printf("%-22s %12.3f %12.3f %12zu%s\n", regex, tree_ms, scan_ms, found,
+                    found == scanned ? "" : "  (distinto!)");
+    }
+    return 0;
+}
@@ -0,0 +1,57 @@
+#include "SuffixTree.h"
+#include "BenchUtil.h"
+#include <cstdio>
+
+/**
+ * Benchmark de rotación de documentos: remove_string + add_string contra
+ * reconstruir el árbol completo.
+ *
+ * Construye el GST de un corpus y rota `rounds` veces: quita el documento
+ * más viejo y agrega uno nuevo. El costo de quitar depende del documento,
+ * no del corpus, así que también se mide con un corpus 4 veces más grande.
+ * Como referencia, se mide una reconstrucción completa.
+ *
+ * Uso: bench_remove_string [documentos] [largo_documento] [rotaciones]
+ */
+
+using aed::structure::SuffixTree;
+using namespace aed::bench;
+
+static void rotate(std::size_t docs, std::size_t doc_len, std::size_t rounds) {
+    auto corpus = dna_corpus(docs, doc_len);
+    std::vector<std::string_view> views(corpus.begin(), corpus.end());
+
+    Timer t;
+    SuffixTree st;
+    st.add_strings(views);
+    double build_ms = t.elapsed_ms();
+
+    auto fresh = dna_corpus(rounds, doc_len, 7777);
+    double remove_ms = 0, add_ms = 0;
+    int oldest = 1;
+    for (std::size_t r = 0; r < rounds; ++r) {
+        t.reset();
+        st.remove_string(oldest++);
+        remove_ms += t.elapsed_ms();
+        t.reset();
+        st.add_string(fresh[r]);
+        add_ms += t.elapsed_ms();
+    }
+
+    std::printf("corpus %zu docs x %zu chars\n", docs, doc_len);
+    std::printf("  reconstruccion completa: %10.2f ms\n", build_ms);
+    std::printf("  remove_string:           %10.4f ms/doc\n", remove_ms / rounds);
+    std::printf("  add_string:              %10.4f ms/doc\n", add_ms / rounds);
+    std::printf("  texto retenido:          %10zu chars (vivo %zu)\n",
+                st.text.size(), (docs) * (doc_len + 1));
+}
+
+int main(int argc, char** argv) {
+    std::size_t docs    = arg_or(argc, argv, 1, 2000);
+    std::size_t doc_len = arg_or(argc, argv, 2, 500);
+    std::size_t rounds  = arg_or(argc, argv, 3, 2000);
+
+    rotate(docs, doc_len, rounds);
+    rotate(docs * 4, doc_len, rounds);
+    return 0;
+}
@@ -0,0 +1,112 @@
+#include "SuffixTree.h"
+#include "MappedSuffixTree.h"
+#include "BenchUtil.h"
+#include <cstdio>
+
+/**
+ * Benchmark de arranque: construir con Ukkonen contra abrir con mmap.
+ *
+ * Construye el GST de un corpus, lo guarda con save() y lo vuelve a abrir
+ * con MappedSuffixTree sin verificar nada, con checksum y con checksum e
+ * índices (validate_indices). Después corre las
+ * mismas consultas sobre ambos y compara los resultados.
+ *
+ * Uso: bench_serialize [documentos] [largo_documento] [consultas] [archivo]
+ */
+
+using aed::structure::SuffixTree;
+using aed::structure::MappedSuffixTree;
+using namespace aed::bench;
+
+int main(int argc, char** argv) {
+    std::size_t docs    = arg_or(argc, argv, 1, 2000);
+    std::size_t doc_len = arg_or(argc, argv, 2, 500);
+    std::size_t queries = arg_or(argc, argv, 3, 200000);
+    std::string path    = argc > 4 ? argv[4] : "bench_serialize.gst";
+
+    auto corpus = dna_corpus(docs, doc_len);
+    std::vector<std::string_view> views(corpus.begin(), corpus.end());
+
+    Timer t;
+    SuffixTree st;
+    st.add_strings(views);
+    st.freeze();
+    double build_ms = t.elapsed_ms();
+
+    t.reset();
+    if (!st.save(path)) {
+        std::printf("error: no se pudo escribir %s\n", path.c_str());
+        return 1;
+    }
+    double save_ms = t.elapsed_ms();
+
+    MappedSuffixTree mapped;
+    t.reset();
+    auto status = mapped.open(path, false);
+    double open_ms = t.elapsed_ms();
+    if (status != MappedSuffixTree::LoadStatus::Ok) {
+        std::printf("error: open devolvio %d\n", static_cast<int>(status));
+        return 1;
+    }
+
+    MappedSuffixTree verified;
+    t.reset();
+    status = verified.open(path, true);
+    double verify_ms = t.elapsed_ms();
+    if (status != MappedSuffixTree::LoadStatus::Ok) {
+        std::printf("error: open (checksum) devolvio %d\n", static_cast<int>(status));
+        return 1;
+    }
+
+    MappedSuffixTree checked;
+    t.reset();
+    status = checked.open(path, true, true);
+    double indices_ms = t.elapsed_ms();
+    if (status != MappedSuffixTree::LoadStatus::Ok) {
+        std::printf("error: open (indices) devolvio %d\n", static_cast<int>(status));
+        return 1;
+    }
+
+    std::vector<std::string> patterns;
+    for (std::size_t q = 0; q < queries; ++q) {
+        patterns.push_back(random_text(4 + q % 9, "ACGT", static_cast<unsigned>(q)));
+    }
+
+    const SuffixTree& frozen = st;
+    std::size_t tree_hits = 0, mapped_hits = 0;
+    t.reset();
+    for (const auto& p : patterns) {
+        tree_hits += static_cast<std::size_t>(frozen.count(p));
+    }
+    double tree_query_ms = t.elapsed_ms();
+    t.reset();
+    for (const auto& p : patterns) {
+        mapped_hits += static_cast<std::size_t>(mapped.count(p));
+    }
+    double mapped_query_ms = t.elapsed_ms();
+
+    if (tree_hits != mapped_hits) {
+        std::printf("error: count en memoria %zu, mapeado %zu\n", tree_hits, mapped_hits);
+        return 1;
+    }
+
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    long bytes = 0;
+    if (f != nullptr) {
+        std::fseek(f, 0, SEEK_END);
+        bytes = std::ftell(f);
+        std::fclose(f);
+    }
+
+    std::printf("corpus: %zu docs x %zu chars, archivo %.2f MB\n", docs, doc_len, bytes / 1048576.0);
+    std::printf("construccion (Ukkonen): %10.2f ms\n", build_ms);
+    std::printf("save:                   %10.2f ms\n", save_ms);
+    std::printf("open (mmap):            %10.2f ms\n", open_ms);
+    std::printf("open (mmap + checksum): %10.2f ms\n", verify_ms);
+    std::printf("open (+ indices):       %10.2f ms\n", indices_ms);
+    std::printf("%zu count() en memoria: %10.2f ms\n", queries, tree_query_ms);
+    std::printf("%zu count() mapeado:    %10.2f ms\n", queries, mapped_query_ms);
+
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include "SlidingWindowSuffixTree.h"
+#include "BenchUtil.h"
+#include <cstdio>
+#include <random>
+
+/**
+ * Benchmark de SlidingWindowSuffixTree sobre un flujo tipo log.
+ *
+ * Pasa el mismo flujo por ventanas de distinto tamaño y reporta el costo
+ * por carácter (debe quedar plano al crecer la ventana y el flujo), la
+ * memoria reservada (proporcional a la ventana, no al flujo) y el tiempo
+ * de consultas is_substring sobre la ventana final.
+ *
+ * Uso: bench_sliding_window [caracteres] [consultas]
+ */
+
+using aed::structure::SlidingWindowSuffixTree;
+using namespace aed::bench;
+
+// Líneas de log sintéticas: pocas plantillas con campos variables
+static std::string log_stream(std::size_t chars, unsigned seed) {
+    static const char* templates[] = {
+        "INFO  request id=%u path=/api/v1/items/%u status=200 ms=%u\n",
+        "WARN  slow query table=orders rows=%u ms=%u user=%u\n",
+        "ERROR upstream timeout host=10.0.%u.%u retry=%u\n",
+        "DEBUG cache hit key=session:%u ttl=%u shard=%u\n",
+    };
+    std::mt19937 rng(seed);
+    std::string out;
+    out.reserve(chars + 128);
+    char line[160];
+    while (out.size() < chars) {
+        const char* fmt = templates[rng() % 4];
+        int n = std::snprintf(line, sizeof(line), fmt, rng() % 100000, rng() % 1000, rng() % 500);
+        out.append(line, static_cast<std::size_t>(n));
+    }
+    out.resize(chars);
+    return out;
+}
+
+int main(int argc, char** argv) {
+    std::size_t chars   = arg_or(argc, argv, 1, 4000000);
+    std::size_t queries = arg_or(argc, argv, 2, 200000);
+
+    std::string stream = log_stream(chars, 1);
+    std::printf("flujo: %zu caracteres\n", chars);
+    std::printf("%10s %12s %12s %12s %12s\n", "ventana", "ns/char", "MB", "nodos", "ns/consulta");
+
+    for (std::size_t window : {1u << 10, 1u << 14, 1u << 18, 1u << 20}) {
+        SlidingWindowSuffixTree st(window);
+
+        Timer t;
+        st.append(stream);
+        double build_ms = t.elapsed_ms();
+
+        // Mitad de patrones sacados de la ventana final, mitad del flujo completo
+        std::string contents = st.contents();
+        std::mt19937 rng(7);
+        std::vector<std::string> patterns;
+        patterns.reserve(queries);
+        for (std::size_t q = 0; q < queries; ++q) {
+            const std::string& src = q % 2 ? contents : stream;
+            std::size_t len = 4 + rng() % 24;
+            std::size_t at = rng() % (src.size() - len);
+            patterns.push_back(src.substr(at, len));
+        }
+        std::size_t hits = 0;
+        t.reset();
+        for (const auto& p : patterns) {
+            hits += st.is_substring(p);
+        }
+        double query_ms = t.elapsed_ms();
+
+        std::printf("%10zu %12.1f %12.2f %12zu %12.1f   (%zu aciertos)\n",
+                    window, build_ms * 1e6 / chars, st.memory_bytes() / 1048576.0,
+                    st.node_count(), query_ms * 1e6 / queries, hits);
+    }
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include "SuffixTree.h"
+#include "BenchUtil.h"
+#include <fstream>
+#include <iterator>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * Benchmark de ingesta de un archivo grande: add_file contra leerlo
+ * completo a un std::string y llamar add_string.
+ *
+ * Cada variante corre en un proceso hijo (fork) para medir su pico de
+ * memoria residente por separado. add_file lee directo a text y extiende
+ * el árbol bloque a bloque, así que nunca tiene el texto dos veces.
+ * Requiere POSIX.
+ *
+ * Uso: bench_stream [caracteres] [bloque] [archivo]
+ */
+
+using aed::structure::SuffixTree;
+using namespace aed::bench;
+
+static long max_rss_kb() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+template<typename Load>
+static void run_isolated(const char* name, Load&& load) {
+    std::fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        long rss_before = max_rss_kb();
+        Timer t;
+        SuffixTree st;
+        int id = load(st);
+        double ms = t.elapsed_ms();
+        std::printf("%s\n", name);
+        std::printf("  tiempo:   %10.2f ms (id %d, %zu caracteres en text)\n", ms, id, st.text.size());
+        std::printf("  pico RSS: %10.2f MB\n", (max_rss_kb() - rss_before) / 1024.0);
+        std::fflush(stdout);
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+}
+
+int main(int argc, char** argv) {
+    std::size_t chars = arg_or(argc, argv, 1, 2000000);
+    std::size_t chunk = arg_or(argc, argv, 2, 1 << 16);
+    std::string path  = argc > 3 ? argv[3] : "bench_stream.txt";
+
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << random_text(chars, "ACGT", 1);
+    }
+
+    std::printf("archivo: %zu caracteres, bloques de %zu\n", chars, chunk);
+
+    run_isolated("leer completo + add_string", [&](SuffixTree& st) {
+        std::ifstream in(path, std::ios::binary);
+        std::string whole((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        return st.add_string(whole);
+    });
+
+    run_isolated("add_file", [&](SuffixTree& st) {
+        return st.add_file(path, chunk).id;
+    });
+
+    std::remove(path.c_str());
+    return 0;
+}
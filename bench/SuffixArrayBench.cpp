@@ -0,0 +1,104 @@
+#include "SuffixTree.h"
+#include "SuffixArrayIndex.h"
+#include "BenchUtil.h"
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * Benchmark SuffixTree (Ukkonen) contra SuffixArrayIndex (SA-IS + LCP).
+ *
+ * Cada motor corre en un proceso hijo (fork) para medir su pico de memoria
+ * residente por separado: se informa el aumento de ru_maxrss durante la
+ * construccion y las consultas. Requiere POSIX.
+ *
+ * Uso: bench_suffix_array [documentos] [largo_documento] [consultas] [largo_patron]
+ */
+
+using aed::structure::SuffixTree;
+using aed::structure::SuffixArrayIndex;
+using namespace aed::bench;
+
+static long max_rss_kb() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+template<typename Engine>
+static void run_engine(const char* name, const std::vector<std::string>& corpus,
+                       const std::vector<std::string>& patterns) {
+    long rss_before = max_rss_kb();
+
+    Timer t;
+    Engine engine;
+    for (const auto& s : corpus) {
+        engine.add_string(s);
+    }
+    // El arreglo de sufijos se construye aparte (SuffixTree no lo necesita)
+    if constexpr (requires { engine.build(); }) {
+        engine.build();
+    }
+    double build_ms = t.elapsed_ms();
+
+    std::size_t hits = 0;
+    t.reset();
+    for (const auto& p : patterns) {
+        hits += engine.is_substring(p);
+    }
+    double query_ms = t.elapsed_ms();
+
+    std::size_t chars = 0;
+    for (const auto& s : corpus) {
+        chars += s.size() + 1;
+    }
+    long rss_kb = max_rss_kb() - rss_before;
+
+    std::printf("%s\n", name);
+    std::printf("  construccion:   %10.2f ms\n", build_ms);
+    std::printf("  pico RSS:       %10.2f MB (%.1f bytes/caracter)\n",
+                rss_kb / 1024.0, rss_kb * 1024.0 / chars);
+    std::printf("  is_substring:   %10.3f us/consulta (%zu aciertos)\n",
+                query_ms * 1000.0 / patterns.size(), hits);
+    std::fflush(stdout);
+}
+
+template<typename Engine>
+static void run_isolated(const char* name, const std::vector<std::string>& corpus,
+                         const std::vector<std::string>& patterns) {
+    std::fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        run_engine<Engine>(name, corpus, patterns);
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+}
+
+int main(int argc, char** argv) {
+    std::size_t docs    = arg_or(argc, argv, 1, 64);
+    std::size_t doc_len = arg_or(argc, argv, 2, 50000);
+    std::size_t queries = arg_or(argc, argv, 3, 200000);
+    std::size_t pat_len = arg_or(argc, argv, 4, 12);
+
+    auto corpus = dna_corpus(docs, doc_len);
+
+    // Mitad presentes (tomados del corpus), mitad aleatorios
+    std::vector<std::string> patterns;
+    patterns.reserve(queries);
+    std::mt19937 rng(3);
+    for (std::size_t q = 0; q < queries; ++q) {
+        if (q % 2 == 0) {
+            const std::string& doc = corpus[rng() % docs];
+            patterns.push_back(doc.substr(rng() % (doc_len - pat_len), pat_len));
+        } else {
+            patterns.push_back(random_text(pat_len, "ACGT", static_cast<unsigned>(q)));
+        }
+    }
+
+    std::printf("corpus: %zu docs x %zu chars, %zu consultas de largo %zu\n", docs, doc_len, queries, pat_len);
+    run_isolated<SuffixTree>("SuffixTree (Ukkonen)", corpus, patterns);
+    run_isolated<SuffixArrayIndex>("SuffixArrayIndex (SA-IS + LCP)", corpus, patterns);
+    return 0;
+}
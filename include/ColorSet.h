@@ -0,0 +1,374 @@
+#ifndef AED_COLOR_SET
+#define AED_COLOR_SET
+
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <utility>
+
+
+namespace aed::structure {
+
+
+/**
+ * ColorSet - Conjunto dinamico de colores (IDs de string, base 0)
+ *
+ * Reemplaza a std::bitset<MAX_STRINGS>: no hay limite fijo de strings y el
+ * costo en memoria depende de cuantos colores tiene realmente cada nodo.
+ * Mantiene la interfaz de bitset (set, test, count, reset, |=, ==) y usa
+ * tres representaciones:
+ *  - En linea: hasta INLINE_IDS ids ordenados, sin memoria dinamica. Es el
+ *    caso de las hojas y de la mayoria de nodos profundos.
+ *  - Dispersa: arreglo dinamico ordenado de ids.
+ *  - Densa: bitset dinamico, cuando ocupa menos que el arreglo de ids.
+ *
+ * count() esta cacheado (O(1)) y un conjunto de un solo color siempre esta
+ * en linea, por lo que first() tambien es O(1) en ese caso.
+ */
+class ColorSet {
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+    static constexpr std::uint32_t INLINE_IDS = 2;
+
+    class const_iterator {
+    public:
+        const_iterator(const ColorSet* s, std::size_t p) : set(s), pos(p) {}
+        std::size_t operator*() const { return set->dense ? pos : set->ids()[pos]; }
+        const_iterator& operator++() {
+            pos = set->dense ? set->next_bit(pos + 1) : pos + 1;
+            return *this;
+        }
+        bool operator==(const const_iterator& o) const { return pos == o.pos; }
+        bool operator!=(const const_iterator& o) const { return pos != o.pos; }
+    private:
+        const ColorSet* set;
+        std::size_t pos;
+    };
+
+    ColorSet() : n(0), cap(0), dense(false) {}
+
+    ColorSet(const ColorSet& o) : n(0), cap(0), dense(false) {
+        *this = o;
+    }
+
+    ColorSet(ColorSet&& o) noexcept : n(o.n), cap(o.cap), dense(o.dense), data(o.data) {
+        o.n = 0;
+        o.cap = 0;
+        o.dense = false;
+    }
+
+    ColorSet& operator=(const ColorSet& o) {
+        if (this == &o)
+            return *this;
+        release();
+        data = o.data;
+        if (o.dense) {
+            data.bits = new std::uint64_t[o.cap];
+            std::copy(o.data.bits, o.data.bits + o.cap, data.bits);
+        } else if (o.cap > 0) {
+            data.sparse = new std::uint32_t[o.cap];
+            std::copy(o.data.sparse, o.data.sparse + o.n, data.sparse);
+        }
+        n = o.n;
+        cap = o.cap;
+        dense = o.dense;
+        return *this;
+    }
+
+    ColorSet& operator=(ColorSet&& o) noexcept {
+        if (this != &o) {
+            release();
+            n = o.n;
+            cap = o.cap;
+            dense = o.dense;
+            data = o.data;
+            o.n = 0;
+            o.cap = 0;
+            o.dense = false;
+        }
+        return *this;
+    }
+
+    ~ColorSet() {
+        release();
+    }
+
+    bool test(std::size_t i) const {
+        if (dense)
+            return i < cap * 64u and (words()[i / 64] >> (i % 64) & 1u);
+        return std::binary_search(ids(), ids() + n, static_cast<std::uint32_t>(i));
+    }
+
+    ColorSet& set(std::size_t i) {
+        if (dense) {
+            grow_dense(i / 64 + 1);
+            std::uint64_t bit = std::uint64_t(1) << (i % 64);
+            if (!(words()[i / 64] & bit)) {
+                words()[i / 64] |= bit;
+                ++n;
+            }
+            return *this;
+        }
+        std::uint32_t id = static_cast<std::uint32_t>(i);
+        std::uint32_t* pos = std::lower_bound(ids(), ids() + n, id);
+        if (pos != ids() + n and *pos == id)
+            return *this;
+        std::size_t at = pos - ids();
+        if (n == capacity()) {
+            if (should_densify(n + 1, std::max<std::size_t>(i, n ? ids()[n - 1] : 0))) {
+                to_dense(i / 64 + 1);
+                return set(i);
+            }
+            grow_sparse(n + 1);
+        }
+        std::uint32_t* a = ids();
+        std::memmove(a + at + 1, a + at, (n - at) * sizeof(std::uint32_t));
+        a[at] = id;
+        ++n;
+        return *this;
+    }
+
+    ColorSet& reset(std::size_t i) {
+        if (!test(i))
+            return *this;
+        if (dense) {
+            words()[i / 64] &= ~(std::uint64_t(1) << (i % 64));
+            --n;
+        } else {
+            std::uint32_t* a = ids();
+            std::uint32_t* pos = std::lower_bound(a, a + n, static_cast<std::uint32_t>(i));
+            std::memmove(pos, pos + 1, (a + n - pos - 1) * sizeof(std::uint32_t));
+            --n;
+        }
+        if (n <= INLINE_IDS and on_heap())
+            shrink_inline();
+        return *this;
+    }
+
+    ColorSet& reset() {
+        release();
+        n = 0;
+        cap = 0;
+        dense = false;
+        return *this;
+    }
+
+    std::size_t count() const { return n; }
+    bool any() const { return n > 0; }
+    bool none() const { return n == 0; }
+
+    /**
+     * Menor color del conjunto o npos si esta vacio.
+     */
+    std::size_t first() const {
+        if (n == 0)
+            return npos;
+        return dense ? next_bit(0) : ids()[0];
+    }
+
+    ColorSet& operator|=(const ColorSet& o) {
+        if (o.n == 0 or this == &o)
+            return *this;
+        if (o.dense or dense) {
+            if (!dense)
+                to_dense(o.dense ? o.cap : o.ids()[o.n - 1] / 64 + 1);
+            if (o.dense) {
+                grow_dense(o.cap);
+                std::size_t total = 0;
+                for (std::uint32_t w = 0; w < cap; ++w) {
+                    if (w < o.cap)
+                        words()[w] |= o.words()[w];
+                    total += std::popcount(words()[w]);
+                }
+                n = static_cast<std::uint32_t>(total);
+            } else {
+                for (std::size_t id : o)
+                    set(id);
+            }
+            return *this;
+        }
+        // Ambos ordenados: mezcla lineal (en la pila si el resultado es chico)
+        std::uint32_t small[16];
+        std::uint32_t total = n + o.n;
+        std::uint32_t* tmp = total <= 16 ? small : new std::uint32_t[total];
+        std::uint32_t m = static_cast<std::uint32_t>(
+            std::set_union(ids(), ids() + n, o.ids(), o.ids() + o.n, tmp) - tmp);
+        std::uint32_t max_id = tmp[m - 1];
+
+        // Sin colores nuevos, o el resultado cabe donde esta: no se reserva
+        if (m == n or (m <= capacity() and !should_densify(m, max_id))) {
+            if (m != n)
+                std::copy(tmp, tmp + m, ids());
+            n = m;
+            if (tmp != small)
+                delete[] tmp;
+            return *this;
+        }
+
+        release();
+        cap = 0;
+        dense = false;
+        if (m <= INLINE_IDS) {
+            std::copy(tmp, tmp + m, data.local);
+        } else if (should_densify(m, max_id)) {
+            n = 0;
+            dense = true;
+            grow_dense(max_id / 64 + 1);
+            for (std::uint32_t k = 0; k < m; ++k)
+                data.bits[tmp[k] / 64] |= std::uint64_t(1) << (tmp[k] % 64);
+        } else if (tmp != small) {
+            data.sparse = tmp;
+            tmp = small;
+            cap = total;
+        } else {
+            data.sparse = new std::uint32_t[m];
+            std::copy(tmp, tmp + m, data.sparse);
+            cap = m;
+        }
+        n = m;
+        if (tmp != small)
+            delete[] tmp;
+        return *this;
+    }
+
+    bool operator==(const ColorSet& o) const {
+        if (n != o.n)
+            return false;
+        const_iterator a = begin(), b = o.begin();
+        for (std::uint32_t k = 0; k < n; ++k, ++a, ++b) {
+            if (*a != *b)
+                return false;
+        }
+        return true;
+    }
+
+    bool operator!=(const ColorSet& o) const {
+        return !(*this == o);
+    }
+
+    const_iterator begin() const { return const_iterator(this, dense ? next_bit(0) : 0); }
+    const_iterator end() const { return const_iterator(this, dense ? cap * std::size_t(64) : n); }
+
+    std::size_t heap_bytes() const {
+        if (!on_heap())
+            return 0;
+        return dense ? cap * sizeof(std::uint64_t) : cap * sizeof(std::uint32_t);
+    }
+
+private:
+    bool on_heap() const { return dense or cap > 0; }
+
+    std::uint32_t capacity() const { return cap > 0 ? cap : INLINE_IDS; }
+
+    std::uint32_t* ids() { return cap > 0 ? data.sparse : data.local; }
+    const std::uint32_t* ids() const { return cap > 0 ? data.sparse : data.local; }
+    std::uint64_t* words() { return data.bits; }
+    const std::uint64_t* words() const { return data.bits; }
+
+    // Un bitset de (max_id + 1) bits ocupa menos que `ids` enteros de 32 bits
+    static bool should_densify(std::size_t ids, std::size_t max_id) {
+        return ids > INLINE_IDS and (max_id / 64 + 1) * 2 <= ids;
+    }
+
+    std::size_t next_bit(std::size_t from) const {
+        for (std::size_t w = from / 64; w < cap; ++w) {
+            std::uint64_t word = words()[w];
+            if (w == from / 64)
+                word &= ~std::uint64_t(0) << (from % 64);
+            if (word)
+                return w * 64 + std::countr_zero(word);
+        }
+        return cap * std::size_t(64);
+    }
+
+    void release() {
+        if (dense)
+            delete[] data.bits;
+        else if (cap > 0)
+            delete[] data.sparse;
+    }
+
+    void grow_sparse(std::size_t need) {
+        std::uint32_t new_cap = static_cast<std::uint32_t>(std::max<std::size_t>(need, 2 * capacity()));
+        std::uint32_t* block = new std::uint32_t[new_cap];
+        std::copy(ids(), ids() + n, block);
+        release();
+        data.sparse = block;
+        cap = new_cap;
+    }
+
+    // Solo en modo denso: asegura al menos need_words palabras (en cero)
+    void grow_dense(std::size_t need_words) {
+        if (need_words <= cap)
+            return;
+        std::uint32_t new_cap = static_cast<std::uint32_t>(std::max<std::size_t>(need_words, 2 * cap));
+        std::uint64_t* block = new std::uint64_t[new_cap]();
+        if (cap > 0)
+            std::copy(data.bits, data.bits + cap, block);
+        if (cap > 0)
+            delete[] data.bits;
+        data.bits = block;
+        cap = new_cap;
+    }
+
+    void to_dense(std::size_t need_words) {
+        std::uint32_t m = n;
+        std::uint32_t local[INLINE_IDS];
+        std::uint32_t* tmp = cap > 0 ? data.sparse : std::copy(data.local, data.local + m, local) - m;
+        std::size_t max_words = m ? tmp[m - 1] / 64 + 1 : 1;
+
+        cap = 0;
+        dense = true;
+        data.bits = nullptr;
+        grow_dense(std::max<std::size_t>(need_words, max_words));
+        for (std::uint32_t k = 0; k < m; ++k)
+            data.bits[tmp[k] / 64] |= std::uint64_t(1) << (tmp[k] % 64);
+        if (tmp != local)
+            delete[] tmp;
+    }
+
+    void shrink_inline() {
+        std::uint32_t local[INLINE_IDS] = {};
+        std::uint32_t k = 0;
+        for (std::size_t id : *this)
+            local[k++] = static_cast<std::uint32_t>(id);
+        release();
+        std::copy(local, local + k, data.local);
+        cap = 0;
+        dense = false;
+    }
+
+    std::uint32_t n;        // cantidad de colores
+    std::uint32_t cap : 31; // capacidad dinamica (ids o palabras de 64 bits); 0 = en linea
+    std::uint32_t dense : 1;
+    union Storage {
+        std::uint32_t local[INLINE_IDS];
+        std::uint32_t* sparse;
+        std::uint64_t* bits;
+    } data;
+};
+
+
+} // namespace aed::structure
+
+
+namespace std {
+
+template<>
+struct hash<aed::structure::ColorSet> {
+    std::size_t operator()(const aed::structure::ColorSet& c) const noexcept {
+        std::size_t h = c.count();
+        for (std::size_t id : c)
+            h ^= id + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+        return h;
+    }
+};
+
+} // namespace std
+
+
+#endif // AED_COLOR_SET
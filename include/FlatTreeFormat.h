@@ -0,0 +1,143 @@
+#ifndef AED_FLAT_TREE_FORMAT
+#define AED_FLAT_TREE_FORMAT
+
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+
+namespace aed::structure::flat {
+
+
+/**
+ * Formato binario plano de un SuffixTree (SuffixTree::save, MappedSuffixTree)
+ *
+ * Sin punteros: los nodos y aristas se referencian por índice y las
+ * etiquetas por posición en text, así que el archivo se usa tal cual desde
+ * mmap sin reconstruir nada. Todo en el orden de bytes de la máquina que
+ * lo escribió.
+ *
+ *   Header | text | string_offsets | nodes | edges | shared | colors
+ *
+ * Cada sección empieza alineada a 8 bytes y se rellena con ceros. Los
+ * nodos están en pre-order: el subárbol de v son los nodos
+ * [v, v.subtree_end), y las aristas de cada nodo son contiguas y están
+ * ordenadas por carácter (como unsigned char).
+ *
+ * Solo las hojas guardan su lista de colores: la de un nodo interno es la
+ * unión de las hojas de su subárbol, y guardarla por nodo ocuparía
+ * O(nodos × strings). Cada nodo guarda solo cuántos colores tiene
+ * (documents), así que document_frequency sigue siendo O(1) y la
+ * sección COLORS mide lo mismo que la cantidad de sufijos.
+ */
+
+inline constexpr char MAGIC[8] = {'A', 'E', 'D', 'G', 'S', 'T', '\0', '\0'};
+inline constexpr std::uint32_t VERSION = 2;
+inline constexpr std::uint32_t ENDIAN_TAG = 0x01020304;
+
+enum SectionId {
+    TEXT,               // char: todos los strings, cada uno terminado en END_TOKEN
+    STRING_OFFSETS,     // int32: string_offsets de SuffixTree (string_count + 1)
+    NODES,              // Node
+    EDGES,              // Edge
+    SHARED,             // Shared: SharedSuffix de SuffixTree
+    COLORS,             // int32: IDs de colores (0-based) de cada hoja, ordenados
+    SECTION_COUNT
+};
+
+struct Section {
+    std::uint64_t offset;   // desde el inicio del archivo
+    std::uint64_t count;    // cantidad de elementos
+};
+
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t endian_tag;
+    std::uint32_t header_size;
+    std::uint32_t node_size;
+    std::uint32_t edge_size;
+    std::uint32_t end_token;
+    std::uint32_t string_count;
+    std::uint32_t reserved;
+    std::uint64_t file_size;
+    std::uint64_t checksum;     // de todo lo que sigue al Header (ver Checksum)
+    Section sections[SECTION_COUNT];
+};
+
+// El checksum empieza justo después del Header: debe terminar alineado
+static_assert(sizeof(Header) % 8 == 0, "Header debe medir un multiplo de 8 bytes");
+
+struct Node {
+    std::int32_t depth;         // igual que SuffixTree::Node::depth
+    std::int32_t first_edge;
+    std::int32_t edge_count;
+    std::int32_t subtree_end;   // primer nodo fuera del subárbol
+    std::int32_t count;         // apariciones de la etiqueta
+    std::int32_t documents;     // cantidad de colores (strings distintos del subárbol)
+    std::int32_t color_begin;   // solo hojas: rango [color_begin, color_begin + color_count) de COLORS
+    std::int32_t color_count;   // solo hojas (0 en nodos internos)
+    std::int32_t suffix_start;  // solo hojas
+    std::int32_t string_id;     // solo hojas (0 en nodos internos)
+    std::int32_t shared;        // solo hojas: primer Shared, -1 si no hay
+};
+
+struct Edge {
+    std::int32_t label;         // posición en text del primer carácter
+    std::int32_t target;        // índice del nodo destino
+    char c;                     // primer carácter de la etiqueta
+    char pad[3];
+};
+
+struct Shared {
+    std::int32_t string_id;
+    std::int32_t start;
+    std::int32_t next;
+};
+
+/**
+ * Checksum - FNV-1a sobre palabras de 64 bits
+ *
+ * update() recibe secciones que empiezan alineadas a 8 bytes: el último
+ * pedazo incompleto se completa con ceros, igual que el relleno del
+ * archivo, así que hashear sección por sección o todo el bloque da lo
+ * mismo.
+ */
+class Checksum {
+public:
+    void update(const void* data, std::size_t bytes) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        std::size_t words = bytes / 8;
+        for (std::size_t i = 0; i < words; ++i, p += 8) {
+            std::uint64_t w;
+            std::memcpy(&w, p, 8);
+            mix(w);
+        }
+        if (std::size_t tail = bytes % 8) {
+            std::uint64_t w = 0;
+            std::memcpy(&w, p, tail);
+            mix(w);
+        }
+    }
+
+    std::uint64_t value() const { return hash; }
+
+private:
+    void mix(std::uint64_t w) {
+        hash ^= w;
+        hash *= 0x100000001b3ULL;
+    }
+
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+};
+
+inline constexpr std::uint64_t align8(std::uint64_t n) {
+    return (n + 7) & ~std::uint64_t{7};
+}
+
+
+} // namespace aed::structure::flat
+
+
+#endif // AED_FLAT_TREE_FORMAT
@@ -0,0 +1,116 @@
+#ifndef AED_MAPPED_SUFFIX_TREE
+#define AED_MAPPED_SUFFIX_TREE
+
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "FlatTreeFormat.h"
+#include "QueryTypes.h"
+
+
+namespace aed::structure {
+
+
+/**
+ * Clase MappedSuffixTree - SuffixTree de solo lectura cargado con mmap
+ *
+ * Abre un archivo escrito por SuffixTree::save y consulta directamente
+ * sobre la memoria mapeada (ver FlatTreeFormat.h): no hay parseo ni
+ * reconstrucción de nodos, la carga es solo traer páginas a memoria y
+ * varios procesos comparten la misma copia a través del page cache.
+ *
+ * Las consultas son las mismas que las const de un SuffixTree congelado
+ * y pueden hacerse desde varios hilos a la vez.
+ */
+class MappedSuffixTree {
+
+public:
+    using Index = int;
+
+    enum class LoadStatus {
+        Ok,
+        OpenFailed,         // No se pudo abrir o mapear el archivo
+        BadMagic,           // No es un archivo de SuffixTree
+        BadVersion,         // Versión de formato u orden de bytes distinto
+        BadLayout,          // Secciones fuera del archivo, tamaños o índices inconsistentes
+        BadChecksum         // El contenido no coincide con el checksum
+    };
+
+    MappedSuffixTree();
+    ~MappedSuffixTree();
+    MappedSuffixTree(const MappedSuffixTree&) = delete;
+    MappedSuffixTree& operator=(const MappedSuffixTree&) = delete;
+
+    LoadStatus open(const std::string& path, bool verify_checksum = true, bool verify_indices = false);
+    void close();
+    bool is_open() const;
+
+    bool is_suffix(std::string_view str) const;
+    bool is_substring(std::string_view str) const;
+    int count(std::string_view pattern) const;
+    int document_frequency(std::string_view pattern) const;
+    std::vector<int> documents(std::string_view pattern) const;
+
+    template<typename Callback>
+    void find_all(std::string_view pattern, Callback&& report) const;
+    std::vector<Occurrence> find_all(std::string_view pattern) const;
+
+    int get_string_count() const;
+    std::string_view get_string(int id) const;
+
+private:
+    LoadStatus validate(bool verify_checksum) const;
+    LoadStatus validate_indices() const;
+    const flat::Node* find_locus(std::string_view pattern, Index* next = nullptr) const;
+    const flat::Edge* find_edge(const flat::Node* node, char c) const;
+    bool contains_end_token(std::string_view str) const;
+
+    // Región mapeada
+    void* base;
+    std::size_t size;
+
+    // Secciones dentro de base (ver FlatTreeFormat.h)
+    const flat::Header* header;
+    const char* text;
+    const std::int32_t* string_offsets;
+    const flat::Node* nodes;
+    const flat::Edge* edges;
+    const flat::Shared* shared;
+    const std::int32_t* colors;
+};
+
+
+/**
+ * find_all - Reporta cada aparición de pattern como Occurrence
+ *
+ * Los nodos están en pre-order, así que las hojas bajo el locus son un
+ * rango contiguo del arreglo: O(m + tamaño del subárbol), sin pila.
+ */
+template<typename Callback>
+void MappedSuffixTree::find_all(std::string_view pattern, Callback&& report) const {
+    if (!is_open() or pattern.empty() or contains_end_token(pattern)) {
+        return;
+    }
+    const flat::Node* locus = find_locus(pattern);
+    if (locus == nullptr) {
+        return;
+    }
+    const flat::Node* end = nodes + locus->subtree_end;
+    for (const flat::Node* n = locus; n != end; ++n) {
+        if (n->string_id == 0) {
+            continue;
+        }
+        report(Occurrence{n->string_id, n->suffix_start - string_offsets[n->string_id - 1]});
+        for (Index e = n->shared; e >= 0; e = shared[e].next) {
+            report(Occurrence{shared[e].string_id, shared[e].start - string_offsets[shared[e].string_id - 1]});
+        }
+    }
+}
+
+
+} // namespace aed::structure
+
+
+#endif // AED_MAPPED_SUFFIX_TREE
@@ -0,0 +1,281 @@
+#ifndef AED_NODE_CHILDREN
+#define AED_NODE_CHILDREN
+
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <new>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+
+namespace aed::structure {
+
+
+/**
+ * Politicas de almacenamiento de hijos de un nodo (char -> T)
+ *
+ * Ambas politicas exponen la misma interfaz para que SuffixTree pueda
+ * cambiar entre ellas sin tocar el algoritmo:
+ *  - find(c):      puntero al valor o nullptr si no existe
+ *  - set(c, v):    inserta o sobrescribe
+ *  - erase(c):     elimina la entrada (true si existia)
+ *  - size(), empty(), clear()
+ *  - begin()/end(): recorrido de entradas con campos `first` y `second`
+ *                   (recorrer con `auto&&` o `const auto&`)
+ *  - heap_bytes(): memoria dinamica usada (para medir)
+ */
+
+
+/**
+ * HashChildren - Tabla hash por nodo (representacion original)
+ */
+template<typename T>
+class HashChildren {
+public:
+    using Map = std::unordered_map<char, T>;
+
+    T* find(char c) {
+        auto it = map.find(c);
+        return it == map.end() ? nullptr : &it->second;
+    }
+
+    const T* find(char c) const {
+        auto it = map.find(c);
+        return it == map.end() ? nullptr : &it->second;
+    }
+
+    void set(char c, const T& value) {
+        map[c] = value;
+    }
+
+    bool erase(char c) {
+        return map.erase(c) > 0;
+    }
+
+    std::size_t size() const { return map.size(); }
+    bool empty() const { return map.empty(); }
+    void clear() { map.clear(); }
+
+    typename Map::iterator begin() { return map.begin(); }
+    typename Map::iterator end() { return map.end(); }
+    typename Map::const_iterator begin() const { return map.begin(); }
+    typename Map::const_iterator end() const { return map.end(); }
+
+    std::size_t heap_bytes() const {
+        // Aproximacion de libstdc++: arreglo de buckets + un nodo por entrada
+        return map.bucket_count() * sizeof(void*)
+             + map.size() * (sizeof(typename Map::value_type) + 2 * sizeof(void*));
+    }
+
+private:
+    Map map;
+};
+
+
+/**
+ * CompactChildren - Arreglo ordenado en linea con desborde a tabla directa
+ *
+ * Hasta N hijos se guardan dentro del propio nodo: las claves ordenadas en un
+ * arreglo de chars y los valores en otro, de modo que la busqueda recorre
+ * unos pocos bytes contiguos sin saltos a memoria dinamica. Al pasar de N
+ * hijos (p. ej. la raiz) las entradas se mueven a un bloque con un indice
+ * directo de 256 posiciones: la busqueda es un acceso indexado.
+ *
+ * Una posicion del indice es valida solo si apunta a una entrada existente
+ * cuyo caracter coincide (truco de "sparse set"), asi borrar no requiere
+ * limpiar el indice.
+ *
+ * Al recorrer se obtienen proxies {first, second&}: usar `auto&&` o `const auto&`.
+ */
+template<typename T, std::size_t N = 4>
+class CompactChildren {
+    static_assert(std::is_trivially_copyable_v<T>, "CompactChildren requiere T trivialmente copiable");
+    static_assert(N < 256, "N debe caber en un byte");
+
+public:
+    template<typename V>
+    struct EntryRef {
+        char first;
+        V& second;
+    };
+
+    template<typename V>
+    class Iterator {
+    public:
+        Iterator(const char* k, V* v) : key(k), val(v) {}
+        EntryRef<V> operator*() const { return {*key, *val}; }
+        Iterator& operator++() { ++key; ++val; return *this; }
+        bool operator==(const Iterator& o) const { return key == o.key; }
+        bool operator!=(const Iterator& o) const { return key != o.key; }
+    private:
+        const char* key;
+        V* val;
+    };
+
+    using iterator = Iterator<T>;
+    using const_iterator = Iterator<const T>;
+
+    CompactChildren() : count(0) {}
+    CompactChildren(const CompactChildren&) = delete;
+    CompactChildren& operator=(const CompactChildren&) = delete;
+
+    T* find(char c) {
+        return const_cast<T*>(std::as_const(*this).find(c));
+    }
+
+    const T* find(char c) const {
+        if (spill) {
+            std::uint8_t i = spill->index[static_cast<unsigned char>(c)];
+            if (i < count and spill->keys()[i] == c)
+                return &spill->vals()[i];
+            return nullptr;
+        }
+        for (std::uint16_t i = 0; i < count; ++i) {
+            if (keys[i] == c)
+                return &vals[i];
+        }
+        return nullptr;
+    }
+
+    void set(char c, const T& value) {
+        if (T* found = find(c)) {
+            *found = value;
+            return;
+        }
+        if (spill) {
+            spill_push(c, value);
+            return;
+        }
+        if (count == N) {
+            spill_out();
+            spill_push(c, value);
+            return;
+        }
+        // Insercion ordenada en el arreglo local
+        std::uint16_t i = count;
+        while (i > 0 and static_cast<unsigned char>(keys[i - 1]) > static_cast<unsigned char>(c)) {
+            keys[i] = keys[i - 1];
+            vals[i] = vals[i - 1];
+            --i;
+        }
+        keys[i] = c;
+        vals[i] = value;
+        ++count;
+    }
+
+    bool erase(char c) {
+        if (spill) {
+            char* k = spill->keys();
+            T* v = spill->vals();
+            std::uint8_t i = spill->index[static_cast<unsigned char>(c)];
+            if (i >= count or k[i] != c)
+                return false;
+            // Se mueve la ultima entrada al hueco
+            k[i] = k[count - 1];
+            v[i] = v[count - 1];
+            spill->index[static_cast<unsigned char>(k[i])] = i;
+            --count;
+            return true;
+        }
+        for (std::uint16_t i = 0; i < count; ++i) {
+            if (keys[i] == c) {
+                for (std::uint16_t j = i + 1; j < count; ++j) {
+                    keys[j - 1] = keys[j];
+                    vals[j - 1] = vals[j];
+                }
+                --count;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    void clear() {
+        spill.reset();
+        count = 0;
+    }
+
+    iterator begin() { return spill ? iterator(spill->keys(), spill->vals()) : iterator(keys, vals); }
+    iterator end() { return spill ? iterator(spill->keys() + count, nullptr) : iterator(keys + count, nullptr); }
+    const_iterator begin() const { return spill ? const_iterator(spill->keys(), spill->vals()) : const_iterator(keys, vals); }
+    const_iterator end() const { return spill ? const_iterator(spill->keys() + count, nullptr) : const_iterator(keys + count, nullptr); }
+
+    std::size_t heap_bytes() const {
+        return spill ? Spill::bytes(spill->capacity) : 0;
+    }
+
+private:
+    // Bloque de desborde: indice directo, luego `capacity` claves y `capacity` valores
+    struct alignas(T) Spill {
+        std::uint8_t index[256];
+        std::uint16_t capacity;
+
+        static std::size_t vals_offset(std::size_t cap) {
+            std::size_t raw = sizeof(Spill) + cap;
+            return (raw + alignof(T) - 1) / alignof(T) * alignof(T);
+        }
+        static std::size_t bytes(std::size_t cap) {
+            return vals_offset(cap) + cap * sizeof(T);
+        }
+
+        char* keys() { return reinterpret_cast<char*>(this + 1); }
+        const char* keys() const { return reinterpret_cast<const char*>(this + 1); }
+        T* vals() { return reinterpret_cast<T*>(reinterpret_cast<char*>(this) + vals_offset(capacity)); }
+        const T* vals() const { return reinterpret_cast<const T*>(reinterpret_cast<const char*>(this) + vals_offset(capacity)); }
+    };
+
+    struct SpillDeleter {
+        void operator()(Spill* block) const { ::operator delete(block); }
+    };
+
+    static std::unique_ptr<Spill, SpillDeleter> make_spill(std::uint16_t capacity) {
+        void* raw = ::operator new(Spill::bytes(capacity));
+        Spill* block = new (raw) Spill;
+        std::memset(block->index, 0xFF, sizeof(block->index));
+        block->capacity = capacity;
+        return std::unique_ptr<Spill, SpillDeleter>(block);
+    }
+
+    void spill_out() {
+        spill = make_spill(2 * N);
+        std::memcpy(spill->keys(), keys, count);
+        std::memcpy(static_cast<void*>(spill->vals()), vals, count * sizeof(T));
+        for (std::uint16_t i = 0; i < count; ++i) {
+            spill->index[static_cast<unsigned char>(keys[i])] = static_cast<std::uint8_t>(i);
+        }
+    }
+
+    void spill_push(char c, const T& value) {
+        if (count == spill->capacity) {
+            // Crecimiento geometrico hasta el alfabeto completo
+            auto bigger = make_spill(static_cast<std::uint16_t>(std::min<std::size_t>(2 * count, 256)));
+            std::memcpy(bigger->index, spill->index, sizeof(spill->index));
+            std::memcpy(bigger->keys(), spill->keys(), count);
+            std::memcpy(static_cast<void*>(bigger->vals()), spill->vals(), count * sizeof(T));
+            spill = std::move(bigger);
+        }
+        spill->keys()[count] = c;
+        spill->vals()[count] = value;
+        spill->index[static_cast<unsigned char>(c)] = static_cast<std::uint8_t>(count);
+        ++count;
+    }
+
+    std::uint16_t count;
+    char keys[N];
+    T vals[N];
+    std::unique_ptr<Spill, SpillDeleter> spill;
+};
+
+
+} // namespace aed::structure
+
+
+#endif // AED_NODE_CHILDREN
@@ -0,0 +1,59 @@
+#ifndef AED_QUERY_TYPES
+#define AED_QUERY_TYPES
+
+
+namespace aed::structure {
+
+
+/**
+ * Tipos de resultado compartidos por los motores de consulta
+ * (SuffixTree y SuffixArrayIndex). Las posiciones son locales al string:
+ * offset 0 es el primer caracter de get_string(string_id).
+ */
+
+/**
+ * Occurrence - Una aparicion de un patron
+ */
+struct Occurrence {
+    int string_id;
+    int offset;
+
+    bool operator==(const Occurrence& o) const {
+        return string_id == o.string_id and offset == o.offset;
+    }
+};
+
+/**
+ * SubstringRef - Un substring dado por posicion, sin copiar caracteres
+ */
+struct SubstringRef {
+    int string_id;
+    int offset;
+    int length;
+
+    bool operator==(const SubstringRef& o) const {
+        return string_id == o.string_id and offset == o.offset and length == o.length;
+    }
+};
+
+/**
+ * ApproximateMatch - Una aparicion aproximada de un patron: el substring
+ * [offset, offset + length) de string_id, a distancia errors del patron
+ */
+struct ApproximateMatch {
+    int string_id;
+    int offset;
+    int length;
+    int errors;
+
+    bool operator==(const ApproximateMatch& o) const {
+        return string_id == o.string_id and offset == o.offset
+           and length == o.length and errors == o.errors;
+    }
+};
+
+
+} // namespace aed::structure
+
+
+#endif // AED_QUERY_TYPES
@@ -0,0 +1,69 @@
+#ifndef AED_REGEX_NFA
+#define AED_REGEX_NFA
+
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+
+namespace aed::structure {
+
+
+/**
+ * Clase RegexNfa - Expresión regular restringida como NFA bit-paralelo
+ *
+ * Sintaxis (una secuencia de elementos, cada uno de un carácter):
+ *  - `x`: el carácter x (`\x` para los especiales `.?[]*+{}\`)
+ *  - `.` o `?`: cualquier carácter
+ *  - `[AG]`, `[a-z]`, `[^CT]`: clase de caracteres (o su complemento)
+ *  - cuantificadores sobre el elemento anterior: `{n}`, `{a,b}`, `*`
+ *    (0 a max_gap veces) y `+` (1 a max_gap veces)
+ * Ejemplos: `AC?GT`, `[AG]TT.*CA`, `GA.{2,5}TC`.
+ *
+ * Cada repetición se expande en copias obligatorias y opcionales, y el
+ * autómata es Shift-And: el bit p está activo si lo leído hasta ahora
+ * termina de cubrir las primeras p posiciones (el bit 0 es el inicio). Las
+ * posiciones opcionales se saltan con la clausura bit-paralela de Navarro
+ * y Raffinot, así que cada paso es O(1) con a lo sumo MAX_POSITIONS
+ * posiciones.
+ *
+ * Los matches están anclados al primer carácter leído (el llamador decide
+ * dónde empezar). No se aceptan expresiones que reconozcan el string vacío.
+ */
+class RegexNfa {
+
+public:
+    using Mask = std::uint64_t;
+
+    // Posiciones del patrón expandido (el bit 0 es el estado inicial)
+    static constexpr int MAX_POSITIONS = 63;
+    static constexpr int DEFAULT_MAX_GAP = 8;
+
+    RegexNfa();
+    bool compile(std::string_view regex, int max_gap = DEFAULT_MAX_GAP);
+    bool is_valid() const;
+    int positions() const;
+
+    Mask start() const;
+    Mask step(Mask active, char c) const;
+    bool accepts(Mask active) const;
+
+private:
+    Mask closure(Mask active) const;
+
+    // chars[c]: posiciones que aceptan c
+    std::array<Mask, 256> chars;
+    // Posiciones opcionales y, por cada bloque de opcionales consecutivas,
+    // la posición anterior (before) y la última (last)
+    Mask optional;
+    Mask before;
+    Mask last;
+    int length;
+};
+
+
+} // namespace aed::structure
+
+
+#endif // AED_REGEX_NFA
@@ -0,0 +1,124 @@
+#ifndef AED_SLIDING_WINDOW_SUFFIX_TREE
+#define AED_SLIDING_WINDOW_SUFFIX_TREE
+
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "NodeChildren.h"
+
+
+namespace aed::structure {
+
+
+/**
+ * Clase SlidingWindowSuffixTree - Árbol de sufijos de una ventana deslizante
+ *
+ * Indexa los últimos `window` caracteres de un flujo sin fin (logs,
+ * sockets): cada push() agrega un carácter con una fase de Ukkonen y, con
+ * la ventana llena, antes borra el sufijo más viejo (Larsson, 1996). Es
+ * un árbol implícito, sin END_TOKEN: cualquier carácter es válido.
+ *
+ * Para que la memoria no dependa del largo del flujo:
+ *  - el texto es un buffer circular de `window` caracteres;
+ *  - las hojas no son nodos: la hoja del sufijo que empieza en p vive en
+ *    la casilla p % window (solo se guarda su padre);
+ *  - los nodos internos (a lo sumo `window`) se reservan de una vez y se
+ *    reciclan con una lista libre.
+ *
+ * Las etiquetas no guardan posiciones de texto: cada nodo interno guarda
+ * pos, el inicio de algún sufijo que pasa por él, y la arista que llega a
+ * v empieza en pos(v) + depth(padre). Ese pos se mantiene dentro de la
+ * ventana con el esquema de créditos de Larsson (ver send_credit), así el
+ * costo por carácter sigue siendo O(1) amortizado.
+ *
+ * Las posiciones son absolutas en el flujo (el primer carácter es el 0);
+ * la ventana es [begin_position(), end_position()).
+ *
+ * Parametros:
+ *  - AED_ST_HASH_CHILDREN: igual que en SuffixTree (opción de CMake
+ *    AED_HASH_CHILDREN)
+ */
+class SlidingWindowSuffixTree {
+
+public:
+    // Posición absoluta en el flujo
+    using Position = std::int64_t;
+
+    explicit SlidingWindowSuffixTree(std::size_t window);
+    void clear();
+
+    void push(char c);
+    void append(std::string_view chunk);
+
+    bool is_substring(std::string_view str) const;
+    Position find(std::string_view str) const;
+
+    std::size_t window() const;
+    std::size_t size() const;
+    Position begin_position() const;
+    Position end_position() const;
+    std::string contents() const;
+    std::size_t node_count() const;
+    std::size_t memory_bytes() const;
+
+private:
+    // Hijo de un nodo: >= 0 es un nodo interno, < 0 es la hoja -(casilla + 1)
+    using Ref = std::int32_t;
+
+#ifdef AED_ST_HASH_CHILDREN
+    using Children = HashChildren<Ref>;
+#else
+    using Children = CompactChildren<Ref>;
+#endif
+
+    struct Node {
+        Children g;
+        Position pos = 0;           // inicio de un sufijo que pasa por el nodo
+        std::int32_t depth = 0;
+        Ref parent = 0;
+        Ref suffix_link = 0;
+        bool credit = false;
+    };
+
+    static constexpr Ref ROOT = 0;
+
+    char at(Position p) const;
+    Ref leaf_ref(Position start) const;
+    Position leaf_start(Ref leaf) const;
+    Position ref_pos(Ref r) const;
+    Position ref_depth(Ref r) const;
+
+    Ref new_node();
+    void free_node(Ref v);
+    void insert(char c);
+    void delete_oldest();
+    Ref split(Ref w, Position f);
+    void merge(Ref v);
+    void canonize(Position end);
+    void send_credit(Ref v, Position i);
+
+    std::size_t capacity;
+    std::unique_ptr<char[]> ring;           // texto: casilla p % capacity
+    std::unique_ptr<Ref[]> leaf_parent;     // padre de la hoja de cada casilla
+    std::unique_ptr<Node[]> nodes;          // nodos internos (0 = raiz)
+    std::vector<Ref> free_nodes;
+    std::size_t used_nodes;
+
+    Position tail;      // primer carácter de la ventana
+    Position front;     // siguiente posición a escribir
+
+    // Punto activo: sufijo más largo que ya aparece antes en la ventana.
+    // Es label(ins) seguido de los últimos proj caracteres leídos.
+    Ref ins;
+    std::int32_t proj;
+};
+
+
+} // namespace aed::structure
+
+
+#endif // AED_SLIDING_WINDOW_SUFFIX_TREE
@@ -0,0 +1,81 @@
+#ifndef AED_SUFFIX_ARRAY_INDEX
+#define AED_SUFFIX_ARRAY_INDEX
+
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "QueryTypes.h"
+
+
+namespace aed::structure {
+
+
+/**
+ * Clase SuffixArrayIndex - Motor alternativo basado en arreglo de sufijos
+ *
+ * Misma superficie de consulta que SuffixTree (is_substring, is_suffix,
+ * distinguishing substrings) pero sin nodos: guarda el texto concatenado,
+ * el arreglo de sufijos (SA-IS, tiempo lineal) y el arreglo LCP (Kasai,
+ * tiempo lineal). En memoria son ~9 bytes por caracter de entrada (texto,
+ * SA y LCP), contra cientos de bytes por caracter del arbol de Ukkonen.
+ *
+ * Los strings se guardan igual que en SuffixTree: uno tras otro en text,
+ * cada uno terminado en END_TOKEN. El LCP se corta en el primer END_TOKEN
+ * (incluido): dos sufijos con LCP igual a su largo hasta END_TOKEN son la
+ * misma hoja del GST, compartida por varios strings.
+ *
+ * No es incremental: add_string invalida los arreglos y build() los
+ * reconstruye completos. Como en SuffixTree::freeze, la construcción es
+ * explícita: las consultas son const (varios hilos pueden consultar un
+ * const SuffixArrayIndex& construido) y sin build() responden false o
+ * vacío.
+ */
+class SuffixArrayIndex {
+
+public:
+    // Caracter terminal que marca el final de cada string (igual que SuffixTree)
+    static constexpr char END_TOKEN = '$';
+
+    using Index = int;
+
+    SuffixArrayIndex();
+    void clear();
+    int add_string(std::string_view str);
+    void build();
+    bool is_built() const;
+
+    bool is_substring(std::string_view str) const;
+    bool is_suffix(std::string_view str) const;
+    std::vector<SubstringRef> distinguishing_substrings() const;
+
+    int get_string_count() const;
+    std::string_view get_string(int id) const;
+    std::size_t memory_bytes() const;
+    const std::vector<Index>& suffix_array() const;
+    const std::vector<Index>& lcp_array() const;
+
+private:
+    std::pair<Index, Index> find_range(std::string_view pattern, bool with_end) const;
+    int compare_suffix(Index pos, std::string_view pattern, bool with_end) const;
+    void build_suffix_array();
+    void build_lcp();
+
+    // Todos los strings concatenados, cada uno terminado en END_TOKEN
+    std::string text;
+    // El string `id` ocupa [string_offsets[id - 1], string_offsets[id]) en text
+    std::vector<Index> string_offsets;
+    // Posiciones de text ordenadas lexicograficamente por sufijo
+    std::vector<Index> sa;
+    // lcp[i] = prefijo comun de sa[i - 1] y sa[i], cortado en END_TOKEN
+    std::vector<Index> lcp;
+    bool built;
+};
+
+
+} // namespace aed::structure
+
+
+#endif // AED_SUFFIX_ARRAY_INDEX
@@ -5,9 +5,17 @@
 #include <iostream>
 #include <unordered_map>
 #include <string>
-#include <bitset>
+#include <string_view>
 #include <algorithm>
+#include <cassert>
 #include <vector>
+#include <memory>
+#include <span>
+#include "NodeChildren.h"
+#include "ColorSet.h"
+#include "QueryTypes.h"
+#include "RegexNfa.h"
+#include "TreeTraversal.h"
 
 
 namespace aed::structure {
@@ -17,29 +25,59 @@ namespace aed::structure {
  * Clase SuffixTree - Implementacion del algoritmo de Ukkonen para GST y dsus
  *
  * Genera un Suffix Tree Generalizado (GST) que puede contener multiples strings.
- * Cada string se identifica con un ID unico.
+ * Cada string se identifica con un ID unico. Los strings se guardan uno tras
+ * otro en un unico buffer (text), separados por END_TOKEN.
  *
  * Caracteriticas adicionales:
- *  - Coloreo de nodos bitsets para identificar string por nodo.
+ *  - Coloreo de nodos (ColorSet dinamico) para identificar string por nodo.
  *  - Busqueda de Distinguidhing Substrings (DSus)
  *
  * Parametros:
- *  - MAX_STRINGS: Maximo numero de substrings que puede contener (por defecto 64, modificable)
  *  - END_TOKEN: Caracter especial que marca el final de cada string (por defecto '$')
+ *  - AED_ST_HASH_CHILDREN: si se define, los hijos de cada nodo se guardan en
+ *    una tabla hash (HashChildren) en vez del arreglo compacto (CompactChildren).
+ *    Cambia el layout de Node: se elige con la opción de CMake
+ *    AED_HASH_CHILDREN, que la define en la librería y en quien la usa
 */
 class SuffixTree {
 
 
 public:
-    // Cantidad de string que haremos coloreo
-    static constexpr std::size_t MAX_STRINGS = 64;
     // Caracter terminal que marca el final de cada string
     static constexpr char END_TOKEN = '$';
 
     // Tip lexico para indices en los strings (simple formato)
     using Index = int;
-    // Tip lexico para coloreo de nodos (simple formato)
-    using ColorSet = std::bitset<MAX_STRINGS>;
+    // Tip lexico para coloreo de nodos (sin limite de strings, ver ColorSet.h)
+    using ColorSet = structure::ColorSet;
+    // Politica de almacenamiento de hijos de cada nodo
+#ifdef AED_ST_HASH_CHILDREN
+    template<typename T> using ChildStorage = HashChildren<T>;
+#else
+    template<typename T> using ChildStorage = CompactChildren<T>;
+#endif
+
+    // Resultado de agregar un string (add_strings informa uno por elemento)
+    enum class AddStatus {
+        Ok,
+        ContainsEndToken,   // El string contiene END_TOKEN
+        TooLong,            // El texto total excederia el rango de Index
+        Frozen,             // El arbol fue congelado con freeze()
+        StreamOpen,         // Hay un string abierto con begin_string()
+        NoStream,           // append/finish_string sin begin_string()
+        ReadFailed          // add_file no pudo leer el archivo
+    };
+
+    // Modelo de errores de find_approximate
+    enum class ErrorModel {
+        Hamming,            // Solo sustituciones (largo igual al patrón)
+        Edit                // Sustituciones, inserciones y borrados
+    };
+
+    struct AddResult {
+        int id;             // ID asignado, -1 si status != Ok
+        AddStatus status;
+    };
 
 
 // private:
@@ -65,25 +103,45 @@ public:
         bool is_valid() const;
     };
 
+    using Children = ChildStorage<Transition>;
+
+    // Parte común a hojas y nodos internos. Las hojas (la mayoría de los
+    // nodos) son solo esto: el bloque de hijos vive en InnerNode
     struct Node {
-        std::unordered_map<char, Transition> g;
         Node* suffix_link;
+        Node* parent;       // nullptr en root y sink
         ColorSet colors;
+        Index depth;        // Largo del camino desde root (en hojas incluye END_TOKEN)
+        Index suffix_start; // Solo hojas: posicion global donde empieza el sufijo
+        int string_id;      // Solo hojas: string que creo la hoja
+        Index shared;       // Solo hojas: primer SharedSuffix del mismo sufijo (-1 si no hay)
+        Index count;        // Apariciones de la etiqueta (ver compute_counts)
+        bool leaf;          // Las hojas implican sufijos completos
         Node();
-        virtual ~Node();
-        virtual Transition find_alpha_transition(char alpha);
+        Children& children();
+        const Children& children() const;
+        Transition find_alpha_transition(char alpha) const;
         void mark_string(int string_id);
         bool has_single_string() const;
         int get_single_string_id() const;
         void merge_colors(const ColorSet& other);
+        // Lo que devuelve children() const en una hoja: vacío y compartido
+        // por todas las hojas, así que no se puede modificar
+        static const Children no_children;
     };
 
-    struct SinkNode : public Node {
-        virtual Transition find_alpha_transition(char aplha) override;
+    // Nodo interno (también root y sink): el único que guarda hijos
+    struct InnerNode : Node {
+        Children g;
     };
 
-    struct Leaf : public Node {
-        // Las hojas implican sufijos completos
+    // Mismo sufijo (terminado en END_TOKEN) en otro string: no tiene hoja
+    // propia y se encadena desde la hoja que lo representa
+    struct SharedSuffix {
+        int string_id;      // 0 si la entrada está libre (ver remove_string)
+        Index start;        // posicion global
+        Index next;         // siguiente de la lista (-1 al final)
+        Index prev;         // anterior de la lista (-1 si es la primera)
     };
 
     struct ReferencePoint {
@@ -93,11 +151,58 @@ public:
         ReferencePoint(Node* n, int ref, Index p);
     };
 
+    struct NodeArena {
+        // Cantidad de nodos por bloque contiguo (slab)
+        static constexpr std::size_t SLAB_NODES = 4096;
+        NodeArena();
+        ~NodeArena();
+        NodeArena(const NodeArena&) = delete;
+        NodeArena& operator=(const NodeArena&) = delete;
+        InnerNode* make_node();
+        Node* make_leaf();
+        void free_node(Node* node);
+        void adopt(NodeArena& other);
+        void release();
+        std::size_t size() const;
+        std::size_t slab_count() const;
+    private:
+        // Nodos de un solo tipo: las hojas y los internos tienen distinto
+        // tamaño, así que cada uno va en sus propios bloques
+        template<typename T>
+        struct Pool {
+#ifdef AED_ST_HEAP_NODES
+            std::vector<T*> loose;
+#else
+            struct alignas(T) Slot {
+                unsigned char bytes[sizeof(T)];
+            };
+            struct Slab {
+                std::unique_ptr<Slot[]> slots;
+                std::size_t used;   // ranuras construidas
+            };
+            std::vector<Slab> slabs;
+#endif
+            // Nodos devueltos con free_node, ya reconstruidos como T()
+            std::vector<T*> free_list;
+            T* make();
+            void free(T* node);
+            void adopt(Pool& other);
+            void release();
+            std::size_t blocks() const;
+        };
+        Pool<InnerNode> inner;
+        Pool<Node> leaves;
+        std::size_t count;
+    };
+
     struct Base {
-        SinkNode sink;
-        Node root;
+        InnerNode sink;     // Sumidero: transicion implicita a root con cualquier caracter
+        InnerNode root;
+        NodeArena arena;
         Base();
         ~Base();
+        Base(const Base&) = delete;
+        Base& operator=(const Base&) = delete;
         void clean();
     };
 
@@ -105,37 +210,328 @@ public:
     // MIEMBROS DE CLASE
 
     Base tree;
-    std::unordered_map<int, std::string> haystack;
+    // Todos los strings concatenados, cada uno terminado en END_TOKEN.
+    // Los MappedSubstring guardan posiciones globales dentro de este buffer.
+    std::string text;
+    // El string `id` ocupa [string_offsets[id - 1], string_offsets[id]) en text
+    std::vector<Index> string_offsets;
+    // Ocurrencias de sufijos compartidos (ver Node::shared)
+    std::vector<SharedSuffix> shared_suffixes;
+    // Entrada de shared_suffixes de cada sufijo compartido, por su start
+    std::unordered_map<Index, Index> shared_at;
+    // Primera entrada libre de shared_suffixes (encadenadas por next)
+    Index free_shared;
+    // removed_ids[id]: el string fue quitado con remove_string. Su texto
+    // sigue en text (dead_chars) hasta la próxima compactación
+    std::vector<bool> removed_ids;
+    Index dead_chars;
     int last_index;
     bool colors_computed;
+    bool counts_computed;
+    bool frozen;
+    // String abierto con begin_string (0 si no hay) y su estado de Ukkonen
+    int stream_id;
+    ReferencePoint stream_point;
+    // Hojas del string abierto, encadenadas por suffix_link (las hojas no
+    // lo usan): su profundidad se conoce recién en finish_string
+    Node* stream_leaves;
 
     // METODOS AUXILIARES
     std::string substring_to_string(const MappedSubstring& substr) const;
-    bool test_and_split(Node* n, MappedSubstring kp, char t, const std::string& w, Node** r);
+    bool test_and_split(Node* n, MappedSubstring kp, char t, Node** r);
     ReferencePoint update(Node* n, MappedSubstring ki);
     ReferencePoint canonize(Node* n, MappedSubstring kp);
-    Index get_starting_node(const std::string &s, ReferencePoint* r);
-    int deploy_suffixes(const std::string& s, int sindex);
-    bool contains_end_token(const std::string& str) const;
-
-    ColorSet compute_colors_dfs(Node* node);
-    void mark_leaves_for_string(int string_id);
-    void get_all_strings_dfs(Node* node, std::string& current_path, std::unordered_map<ColorSet, std::vector<std::string>>& result);
+    Index get_starting_node(std::string_view s, ReferencePoint* r);
+    int deploy_suffixes(int sindex);
+    ReferencePoint extend(ReferencePoint active_point, int sindex, Index i);
+    void extend_stream(Index begin, Index end);
+    void discard_stream();
+    void mark_shared_suffixes(ReferencePoint active_point, int sindex);
+    Index push_shared(Node* leaf, int string_id, Index start);
+    void unlink_shared(Node* leaf, Index entry);
+    bool is_removed(int id) const;
+    void compact_text();
+    int store_string(std::string_view str);
+    bool contains_end_token(std::string_view str) const;
+    AddStatus check_string(std::string_view str) const;
+
+    static void shift_tree(SuffixTree& part, Index offset_shift, int id_shift, Index shared_shift);
+    void merge_tree(Base& into, Base& from, std::vector<std::pair<Node*, Node*>>& absorbed);
+    void absorb_leaf(Node* into, Node* from);
+    const Node* find_locus(std::string_view pattern, Index* next = nullptr) const;
+    template<typename Callback>
+    void report_leaf(const Node* leaf, Callback& report) const;
+    template<typename Callback>
+    void enumerate_repeats(bool supermaximal, Index min_length, Callback& report) const;
+    void search_hamming(std::string_view pattern, int k, std::vector<ApproximateMatch>& out) const;
+    void search_edit(std::string_view pattern, int k, std::vector<ApproximateMatch>& out) const;
+    template<typename Callback>
+    void report_subtree(const Node* node, Callback& report) const;
+    void rebuild_suffix_links();
+
+    const ColorSet& compute_colors_dfs(Node* node);
+    Index compute_counts_dfs(Node* node);
+    void propagate_color(Node* node, int string_id);
+    void get_all_strings_dfs(const Node* node, std::string& current_path, std::unordered_map<ColorSet, std::vector<std::string>>& result) const;
 
 // public:
 
     SuffixTree();
-    int add_string(const std::string &str);
-    bool is_suffix(const std::string& str);
-    bool is_substring(const std::string& str);
+    void clear();
+    int add_string(std::string_view str);
+    std::vector<AddResult> add_strings(std::span<const std::string_view> strs);
+    std::vector<AddResult> add_strings_parallel(std::span<const std::string_view> strs, unsigned threads = 0);
+    AddStatus begin_string();
+    AddStatus append(std::string_view chunk);
+    AddResult finish_string();
+    AddResult add_file(const std::string& path, std::size_t chunk_size = 1 << 20);
+    bool remove_string(int id);
+    bool is_suffix(std::string_view str) const;
+    bool is_substring(std::string_view str) const;
+    std::size_t query_batch(std::span<const std::string_view> patterns, std::span<bool> found) const;
     int get_string_count() const;
-    std::string get_string(int id) const;
+    std::string_view get_string(int id) const;
     void compute_colors();
-
-    std::unordered_map<ColorSet, std::vector<std::string>> get_all_strings(Node* node);
+    void compute_counts();
+    bool freeze();
+    bool is_frozen() const;
+    bool save(const std::string& path);
+
+    template<typename Callback>
+    void find_all(std::string_view pattern, Callback&& report) const;
+    std::vector<Occurrence> find_all(std::string_view pattern) const;
+    std::vector<ApproximateMatch> find_approximate(std::string_view pattern, int k,
+                                                   ErrorModel model = ErrorModel::Edit) const;
+    std::vector<SubstringRef> find_regex(std::string_view regex, int max_gap = RegexNfa::DEFAULT_MAX_GAP) const;
+    int count(std::string_view pattern) const;
+    int document_frequency(std::string_view pattern) const;
+
+    std::unordered_map<ColorSet, std::vector<std::string>> get_all_strings(const Node* node) const;
+    std::vector<SubstringRef> distinguishing_substrings() const;
+    std::vector<SubstringRef> longest_common_substring(int k) const;
+    bool matching_statistics(std::string_view query, std::span<Index> out) const;
+    template<typename Callback>
+    void maximal_repeats(Callback&& report, Index min_length = 1) const;
+    template<typename Callback>
+    void supermaximal_repeats(Callback&& report, Index min_length = 1) const;
 };
 
 
+/**
+ * children - Hijos del nodo, para modificarlos. Solo nodos internos: una
+ * hoja no tiene bloque de hijos
+ */
+inline SuffixTree::Children& SuffixTree::Node::children() {
+    assert(!leaf);
+    return static_cast<InnerNode*>(this)->g;
+}
+
+/**
+ * children - Hijos del nodo. Una hoja no tiene: devuelve no_children
+ */
+inline const SuffixTree::Children& SuffixTree::Node::children() const {
+    return leaf ? no_children : static_cast<const InnerNode*>(this)->g;
+}
+
+
+/**
+ * find_all - Reporta cada aparición de pattern como Occurrence
+ *
+ * Baja hasta el locus de pattern (O(m)) y recorre las hojas de su
+ * subárbol; cada nodo interno tiene al menos dos hijos, así que el
+ * recorrido es O(occ). No construye strings intermedios. No reporta nada
+ * con un string abierto (begin_string sin finish_string).
+ *
+ * @param report: se llama con cada Occurrence (sin orden definido)
+ */
+template<typename Callback>
+void SuffixTree::find_all(std::string_view pattern, Callback&& report) const {
+    if (stream_id != 0 or pattern.empty() or contains_end_token(pattern)) {
+        return;
+    }
+    const Node* locus = find_locus(pattern);
+    if (locus == nullptr) {
+        return;
+    }
+    if (locus->leaf) {
+        report_leaf(locus, report);
+        return;
+    }
+    // Las hojas se reportan al ver la arista, sin apilarlas
+    std::vector<const Node*> stack{locus};
+    while (!stack.empty()) {
+        const Node* n = stack.back();
+        stack.pop_back();
+        for (auto&& child : n->children()) {
+            const Node* tgt = child.second.tgt;
+            if (tgt->leaf) {
+                report_leaf(tgt, report);
+            } else {
+                stack.push_back(tgt);
+            }
+        }
+    }
+}
+
+/**
+ * report_subtree - Reporta cada sufijo del subárbol de node (ver find_all)
+ */
+template<typename Callback>
+void SuffixTree::report_subtree(const Node* node, Callback& report) const {
+    std::vector<const Node*> stack{node};
+    while (!stack.empty()) {
+        const Node* n = stack.back();
+        stack.pop_back();
+        if (n->leaf) {
+            report_leaf(n, report);
+            continue;
+        }
+        for (auto&& child : n->children()) {
+            stack.push_back(child.second.tgt);
+        }
+    }
+}
+
+/**
+ * report_leaf - Reporta el sufijo de la hoja y los compartidos con ella
+ */
+template<typename Callback>
+void SuffixTree::report_leaf(const Node* leaf, Callback& report) const {
+    report(Occurrence{leaf->string_id, leaf->suffix_start - string_offsets[leaf->string_id - 1]});
+    for (Index e = leaf->shared; e >= 0; e = shared_suffixes[e].next) {
+        const SharedSuffix& occ = shared_suffixes[e];
+        report(Occurrence{occ.string_id, occ.start - string_offsets[occ.string_id - 1]});
+    }
+}
+
+
+/**
+ * maximal_repeats - Reporta cada repetición maximal
+ *
+ * Una repetición maximal aparece al menos dos veces y no puede extenderse
+ * a la derecha ni a la izquierda sin perder apariciones: su locus es un
+ * nodo interno (o una hoja compartida, que termina varios strings) con
+ * caracteres a la izquierda distintos. El inicio y el final de un string
+ * cuentan como contextos únicos.
+ *
+ * @param report: report(length, std::span<const Occurrence>) por cada
+ *                repetición; el span solo es válido durante la llamada
+ * @param min_length: largo mínimo a reportar
+ */
+template<typename Callback>
+void SuffixTree::maximal_repeats(Callback&& report, Index min_length) const {
+    enumerate_repeats(false, min_length, report);
+}
+
+/**
+ * supermaximal_repeats - Reporta cada repetición maximal que no es
+ * substring de otra repetición
+ *
+ * Su locus solo tiene hojas que no se repiten como hijas y cada aparición
+ * tiene un carácter a la izquierda distinto. Mismos parámetros que
+ * maximal_repeats.
+ */
+template<typename Callback>
+void SuffixTree::supermaximal_repeats(Callback&& report, Index min_length) const {
+    enumerate_repeats(true, min_length, report);
+}
+
+/**
+ * enumerate_repeats - Post-order común a maximal_repeats y
+ * supermaximal_repeats
+ *
+ * Mismo recorrido que compute_colors_dfs, pero lo que sube de cada hijo
+ * es su diversidad a la izquierda: el único carácter que precede a todas
+ * sus apariciones, o DIVERSE. Las apariciones se acumulan en orden de
+ * hojas, así que las de cada subárbol son un rango contiguo de un solo
+ * vector: O(#nodos + #sufijos compartidos) memoria y tiempo, más lo que
+ * cueste report. No depende de los colores.
+ *
+ * No reporta nada con un string abierto (begin_string sin finish_string).
+ */
+template<typename Callback>
+void SuffixTree::enumerate_repeats(bool supermaximal, Index min_length, Callback& report) const {
+    if (stream_id != 0) {
+        return;
+    }
+
+    // Contexto a la izquierda: un carácter (0-255), o alguno de estos
+    constexpr int NONE = -1;
+    constexpr int DIVERSE = 256;
+    constexpr int START = 257;      // inicio de string: distinto de todos
+    auto merge = [](int a, int b) {
+        if (a == NONE or b == NONE) {
+            return a == NONE ? b : a;
+        }
+        return a == b and a != START ? a : DIVERSE;
+    };
+    auto left_of = [this](const Occurrence& occ) {
+        return occ.offset == 0
+            ? START
+            : static_cast<int>(static_cast<unsigned char>(text[string_offsets[occ.string_id - 1] + occ.offset - 1]));
+    };
+
+    struct Frame {
+        std::size_t begin;  // primera aparición del subárbol en occurrences
+        int left;
+        bool only_leaves;   // todos los hijos son hojas que no se repiten
+    };
+    std::vector<Frame> open;
+    std::vector<Occurrence> occurrences;
+    std::vector<char> seen(START + 1, 0);
+
+    DepthFirst<const Node>().run(&tree.root,
+        [&](const Node* n, const Transition*) {
+            Frame f{occurrences.size(), NONE, true};
+            if (n->leaf) {
+                auto push = [&](Occurrence occ) {
+                    occurrences.push_back(occ);
+                    f.left = merge(f.left, left_of(occ));
+                };
+                report_leaf(n, push);
+            }
+            open.push_back(f);
+            return true;
+        },
+        [&](const Node* n, const Transition* trans) {
+            Frame f = open.back();
+            open.pop_back();
+            if (trans == nullptr) {
+                return;
+            }
+            std::span<const Occurrence> occs(occurrences.data() + f.begin, occurrences.size() - f.begin);
+            Index edge = n->depth - n->parent->depth;
+            // Una hoja es una repetición si termina varios strings; si su
+            // arista es solo END_TOKEN, es la misma que su padre
+            bool repeat = occs.size() >= 2 and (!n->leaf or edge > 1);
+            Index length = n->leaf ? n->depth - 1 : n->depth;
+
+            if (repeat and length >= min_length and f.left == DIVERSE) {
+                bool report_it = true;
+                // Solo se revisan nodos con hijos hoja: cada aparición, a lo sumo dos veces
+                if (supermaximal and !f.only_leaves) {
+                    report_it = false;
+                } else if (supermaximal) {
+                    for (const Occurrence& occ : occs) {
+                        int c = left_of(occ);
+                        report_it = report_it and !seen[c];
+                        seen[c] = c != START;
+                    }
+                    for (const Occurrence& occ : occs) {
+                        seen[left_of(occ)] = 0;
+                    }
+                }
+                if (report_it) {
+                    report(length, occs);
+                }
+            }
+
+            Frame& up = open.back();
+            up.left = merge(up.left, f.left);
+            up.only_leaves = up.only_leaves and n->leaf and !repeat;
+        });
+}
+
 }
 
 
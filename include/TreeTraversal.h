@@ -0,0 +1,102 @@
+#ifndef AED_TREE_TRAVERSAL
+#define AED_TREE_TRAVERSAL
+
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace aed::structure {
+
+
+/**
+ * DepthFirst - Recorrido en profundidad con pila explicita
+ *
+ * Reemplaza a las funciones recursivas sobre el arbol: en entradas de baja
+ * entropia ("aaaa...", regiones repetitivas) la profundidad llega al largo
+ * del string y la recursion desborda la pila del proceso.
+ *
+ * Cada marco guarda el nodo, la arista por la que se llego y la posicion
+ * del recorrido de sus hijos, asi que la memoria es un solo vector de
+ * marcos que crece geometricamente. El mismo objeto puede reutilizarse en
+ * varios recorridos para no volver a reservar.
+ *
+ * run(root, enter, leave):
+ *  - enter(node, edge): al llegar al nodo (pre-order). edge es la
+ *    Transition desde el padre, o nullptr en root. Si devuelve false no se
+ *    visitan sus hijos (pero si se llama leave).
+ *  - leave(node, edge): al terminar su subarbol (post-order).
+ *
+ * Una hoja (node->leaf) no se apila: se llama enter y leave seguidos,
+ * sin pedirle children(), que solo tienen los nodos internos.
+ *
+ * El arbol no debe modificarse durante el recorrido.
+ */
+template<typename NodeT>
+class DepthFirst {
+    using ChildIter = decltype(std::declval<NodeT&>().children().begin());
+    using Edge = std::remove_reference_t<decltype(((*std::declval<ChildIter>()).second))>;
+
+    struct Frame {
+        NodeT* node;
+        Edge* edge;
+        ChildIter next;
+        ChildIter end;
+    };
+
+public:
+    template<typename Enter, typename Leave>
+    void run(NodeT* root, Enter&& enter, Leave&& leave) {
+        stack.clear();
+        push(root, nullptr, enter, leave);
+
+        while (!stack.empty()) {
+            Frame& top = stack.back();
+            if (top.next == top.end) {
+                NodeT* node = top.node;
+                Edge* edge = top.edge;
+                stack.pop_back();
+                leave(node, edge);
+                continue;
+            }
+            Edge& child = (*top.next).second;
+            ++top.next;
+            // push puede reubicar el vector: no usar `top` despues
+            push(child.tgt, &child, enter, leave);
+        }
+    }
+
+    /**
+     * Solo pre-order: visit(node, edge) devuelve false para no descender.
+     */
+    template<typename Visit>
+    void run(NodeT* root, Visit&& visit) {
+        run(root, std::forward<Visit>(visit), [](NodeT*, Edge*) {});
+    }
+
+private:
+    template<typename Enter, typename Leave>
+    void push(NodeT* node, Edge* edge, Enter& enter, Leave& leave) {
+        if (node->leaf) {
+            enter(node, edge);
+            leave(node, edge);
+            return;
+        }
+        auto& children = node->children();
+        if (enter(node, edge)) {
+            stack.push_back({node, edge, children.begin(), children.end()});
+        } else {
+            stack.push_back({node, edge, children.end(), children.end()});
+        }
+    }
+
+    std::vector<Frame> stack;
+};
+
+
+} // namespace aed::structure
+
+
+#endif // AED_TREE_TRAVERSAL
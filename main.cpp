@@ -11,6 +11,7 @@ struct StepState {
     aed::structure::SuffixTree::ReferencePoint active_point = {nullptr,0,0};
     int i = 0;
     int sindex = 0;
+    int base = 0;   // posicion global del string dentro de tree.text
     std::string s;
 };
 
@@ -100,7 +101,7 @@ int main() {
 
             if (event.type == sf::Event::KeyPressed) {
                 if (event.key.code == sf::Keyboard::C) {
-                    tree = aed::structure::SuffixTree();
+                    tree.clear();
                     step = StepState();
                     currentStringIndex = 0;
                 }
@@ -119,11 +120,10 @@ int main() {
                         if (!step.initialized) {
 
                             const std::string& str = stringsToAdd[currentStringIndex];
-                            tree.last_index++;
-                            step.sindex = tree.last_index;
+                            step.sindex = tree.store_string(str);
+                            step.base = tree.string_offsets[step.sindex - 1];
 
                             step.s = str + aed::structure::SuffixTree::END_TOKEN;
-                            tree.haystack[tree.last_index] = step.s;
 
                             step.active_point = {
                                 &tree.tree.root,
@@ -133,9 +133,11 @@ int main() {
 
                             step.i = tree.get_starting_node(step.s, &step.active_point);
                             if (step.i == std::numeric_limits<int>::max()) {
-                                std::cerr << "Error starting node\n";
-                                return -1;
+                                // Ya existe completo: se recorre desde la raiz
+                                step.active_point = {&tree.tree.root, step.sindex, 0};
+                                step.i = 0;
                             }
+                            step.active_point.pos += step.base;
 
                             step.initialized = true;
                         }
@@ -145,7 +147,7 @@ int main() {
                             aed::structure::SuffixTree::MappedSubstring ki(
                                 step.sindex,
                                 step.active_point.pos,
-                                step.i
+                                step.base + step.i
                             );
 
                             step.active_point =
@@ -160,8 +162,7 @@ int main() {
 
                         } else {
                             // ========= TERMINA LA CADENA =========
-                            tree.colors_computed = false;
-                            tree.compute_colors();
+                            tree.mark_shared_suffixes(step.active_point, step.sindex);
                             currentStringIndex++;
 
                             step = StepState();
@@ -1,5 +1,7 @@
 #include "../include/SuffixTree.h"
-#include <list>
+#include <iterator>
+#include <new>
+#include <type_traits>
 
 namespace aed::structure {
 
@@ -7,10 +9,11 @@ namespace aed::structure {
     using Node            = ST::Node;
     using MappedSubstring = ST::MappedSubstring;
     using Transition      = ST::Transition;
-    using SinkNode        = ST::SinkNode;
-    using Leaf            = ST::Leaf;
     using ReferencePoint  = ST::ReferencePoint;
     using Base            = ST::Base;
+    using InnerNode       = ST::InnerNode;
+    using Children        = ST::Children;
+    using NodeArena       = ST::NodeArena;
     using Index           = ST::Index;
 
 
@@ -62,31 +65,47 @@ namespace aed::structure {
      * Node - Nodo del árbol con coloreo
      *
      * Contiene:
-     * - g: mapa de transiciones (hashtable indexado por primer carácter)
+     * - children(): transiciones indexadas por primer carácter (ver
+     *   ChildStorage). Solo las guarda InnerNode (g); una hoja es un Node
+     *   sin bloque de hijos y children() const le devuelve no_children
      * - suffix_link: enlace de sufijo a otro nodo (usado por Ukkonen)
-     * - ColorSet: Un bitset que indica que string de conjunto pasan por
-     *   este nodo.
+     * - parent, depth: padre y largo del camino desde la raíz
+     * - ColorSet: Conjunto dinámico que indica que string de conjunto
+     *   pasan por este nodo.
+     * - leaf: marca de hoja (las hojas son Node y los internos InnerNode)
+     * - string_id, suffix_start: en hojas, string que la creó y posición
+     *   global donde empieza su sufijo (se fijan al crear la hoja)
+     * - shared: en hojas, lista de otros strings con el mismo sufijo
+     * - count: apariciones de la etiqueta del nodo en todos los strings
+     *   (hojas del subárbol más sus sufijos compartidos)
+     *
+     * No tiene metodos virtuales: el sumidero (Base::sink) se trata como
+     * caso especial en canonize y test_and_split.
      */
 
-    Node::Node() : suffix_link(nullptr) {
+    static_assert(!std::is_polymorphic_v<InnerNode>, "Node no debe tener vtable");
+
+    const Children Node::no_children;
+
+    Node::Node()
+        : suffix_link(nullptr), parent(nullptr), depth(0),
+          suffix_start(0), string_id(0), shared(-1), count(0), leaf(false) {
         colors.reset(); // Iniciar los bits en 0
     }
 
-    Node::~Node() {}
-
     /**
      * Busca la transición que comienza con el carácter alpha
      * Retorna una transición inválida si no existe
      */
-    Transition Node::find_alpha_transition(char alpha) {
-        auto it = g.find(alpha);
-        if (it == g.end())
+    Transition Node::find_alpha_transition(char alpha) const {
+        const Transition* t = children().find(alpha);
+        if (t == nullptr)
             return Transition(MappedSubstring(0, 0, -1), nullptr);
-        return it->second;
+        return *t;
     }
 
     void Node::mark_string(int string_id) {
-        if(string_id > 0 and string_id <= ST::MAX_STRINGS) {
+        if(string_id > 0) {
             colors.set(string_id - 1);
         }
     }
@@ -97,11 +116,7 @@ namespace aed::structure {
 
     int Node::get_single_string_id() const {
         if(!has_single_string()) return -1;
-        for(size_t i = 0; i < ST::MAX_STRINGS; ++i)
-            if(colors.test(i))
-                return i + 1;
-
-        return -1;
+        return static_cast<int>(colors.first()) + 1;
     }
 
     void Node::merge_colors(const ST::ColorSet& other) {
@@ -109,19 +124,6 @@ namespace aed::structure {
     }
 
 
-    /**
-    * SinkNode - Nodo especial "sumidero"
-    *
-    * Este nodo auxiliar tiene una transición implícita para CUALQUIER carácter
-    * que apunta de vuelta a la raíz. Se usa en el algoritmo de Ukkonen.
-    */
-
-    //    Especializacion de SinkNode
-    Transition SinkNode::find_alpha_transition(char alpha) {
-        return Transition(MappedSubstring(0, 0, 0), this->suffix_link);
-    }
-
-
     /**
      * ReferencePoint - Punto de referencia en el árbol
      *
@@ -139,10 +141,188 @@ namespace aed::structure {
 
 
 
+    /**
+     * NodeArena - Almacen de nodos por bloques contiguos
+     *
+     * Todos los nodos internos y hojas del arbol se construyen (placement new)
+     * sobre bloques de SLAB_NODES ranuras: las hojas (Node) en unos y los
+     * nodos internos (InnerNode, con el bloque de hijos) en otros, asi cada
+     * ranura mide lo que su nodo. release() destruye todo y devuelve
+     * los bloques completos, por lo que el costo de liberar memoria es
+     * O(#bloques) en vez de O(#nodos). Los nodos que quita remove_string
+     * vuelven con free_node a una lista libre y se reusan antes de tomar
+     * ranuras nuevas.
+     *
+     * Con la opción de CMake AED_HEAP_NODES (define AED_ST_HEAP_NODES en la
+     * librería y en quien la usa) se vuelve a reservar cada nodo con
+     * new/delete (solo para comparar en los benchmarks).
+     */
+
+    NodeArena::NodeArena() : count(0) {}
+
+    InnerNode* NodeArena::make_node() {
+        ++count;
+        return inner.make();
+    }
+
+    Node* NodeArena::make_leaf() {
+        ++count;
+        Node* leaf = leaves.make();
+        leaf->leaf = true;
+        return leaf;
+    }
+
+    /**
+     * Devuelve un nodo a la lista libre de su tipo. Se reconstruye en el
+     * momento (así libera la memoria de sus hijos y colores) y queda listo
+     * para make_node o make_leaf; release() lo destruye junto con el resto
+     * de su bloque.
+     */
+    void NodeArena::free_node(Node* node) {
+        if (node->leaf) {
+            leaves.free(node);
+        } else {
+            inner.free(static_cast<InnerNode*>(node));
+        }
+        --count;
+    }
+
+    /**
+     * Toma los nodos de other (pasan a ser de esta arena sin moverse de
+     * lugar).
+     */
+    void NodeArena::adopt(NodeArena& other) {
+        inner.adopt(other.inner);
+        leaves.adopt(other.leaves);
+        count += other.count;
+        other.count = 0;
+    }
+
+    void NodeArena::release() {
+        inner.release();
+        leaves.release();
+        count = 0;
+    }
+
+    std::size_t NodeArena::slab_count() const {
+        return inner.blocks() + leaves.blocks();
+    }
+
+    template<typename T>
+    void NodeArena::Pool<T>::free(T* node) {
+        node->~T();
+        new (node) T();
+        free_list.push_back(node);
+    }
+
+#ifdef AED_ST_HEAP_NODES
+
+    template<typename T>
+    T* NodeArena::Pool<T>::make() {
+        if (!free_list.empty()) {
+            T* node = free_list.back();
+            free_list.pop_back();
+            return node;
+        }
+        loose.push_back(new T());
+        return loose.back();
+    }
+
+    template<typename T>
+    void NodeArena::Pool<T>::release() {
+        for (T* node : loose) {
+            delete node;
+        }
+        loose.clear();
+        free_list.clear();
+    }
+
+    template<typename T>
+    void NodeArena::Pool<T>::adopt(Pool& other) {
+        loose.insert(loose.end(), other.loose.begin(), other.loose.end());
+        free_list.insert(free_list.end(), other.free_list.begin(), other.free_list.end());
+        other.loose.clear();
+        other.free_list.clear();
+    }
+
+    template<typename T>
+    std::size_t NodeArena::Pool<T>::blocks() const {
+        return loose.size();
+    }
+
+#else
+
+    /**
+     * Devuelve un nodo de la lista libre o la siguiente ranura libre,
+     * abriendo un bloque nuevo cuando el actual se llena.
+     */
+    template<typename T>
+    T* NodeArena::Pool<T>::make() {
+        if (!free_list.empty()) {
+            T* node = free_list.back();
+            free_list.pop_back();
+            return node;
+        }
+        if (slabs.empty() or slabs.back().used == SLAB_NODES) {
+            slabs.push_back({std::unique_ptr<Slot[]>(new Slot[SLAB_NODES]), 0});
+        }
+        return new (slabs.back().slots[slabs.back().used++].bytes) T();
+    }
+
+    /**
+     * Destruye todos los nodos y devuelve los bloques.
+     * Si T es trivialmente destructible solo se liberan los bloques.
+     */
+    template<typename T>
+    void NodeArena::Pool<T>::release() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (Slab& slab : slabs) {
+                for (std::size_t j = 0; j < slab.used; ++j) {
+                    std::launder(reinterpret_cast<T*>(slab.slots[j].bytes))->~T();
+                }
+            }
+        }
+        slabs.clear();
+        free_list.clear();
+    }
+
+    /**
+     * Toma los bloques de other. El bloque en uso de este pool sigue
+     * siendo el ultimo para no desperdiciar sus ranuras libres.
+     */
+    template<typename T>
+    void NodeArena::Pool<T>::adopt(Pool& other) {
+        auto at = slabs.empty() ? slabs.end() : slabs.end() - 1;
+        slabs.insert(at, std::make_move_iterator(other.slabs.begin()),
+                     std::make_move_iterator(other.slabs.end()));
+        free_list.insert(free_list.end(), other.free_list.begin(), other.free_list.end());
+        other.slabs.clear();
+        other.free_list.clear();
+    }
+
+    template<typename T>
+    std::size_t NodeArena::Pool<T>::blocks() const {
+        return slabs.size();
+    }
+
+#endif
+
+    NodeArena::~NodeArena() {
+        release();
+    }
+
+    std::size_t NodeArena::size() const {
+        return count;
+    }
+
+
+
     /**
      * Base - Estructura base del árbol
      *
-     * Maneja la raíz, el nodo sumidero y la limpieza de memoria.
+     * Maneja la raíz, el nodo sumidero y el almacen de nodos (arena).
+     * El sumidero tiene, para cualquier carácter, una transición implícita
+     * de largo 1 hacia la raíz (ver canonize y test_and_split).
      * Los enlaces de sufijo iniciales son:
      * - root -> sink
      * - sink -> root
@@ -151,6 +331,7 @@ namespace aed::structure {
     Base::Base() : sink(), root() {
         root.suffix_link = &sink;
         sink.suffix_link = &root;
+        sink.depth = -1;
     }
 
     Base::~Base() {
@@ -158,23 +339,15 @@ namespace aed::structure {
     }
 
     /**
-     * Limpia todos los nodos del árbol usando BFS
+     * Libera todos los nodos del árbol devolviendo los bloques de la arena
+     * y deja la raíz sin transiciones.
      * No elimina root ni sink (son miembros de la clase)
      */
     void Base::clean() {
-        std::list<Node*> del_list{&root};
-        while (!del_list.empty()) {
-            Node* current = del_list.front();
-            del_list.pop_front();
-
-            for (auto& pair : current->g) {
-                del_list.push_back(pair.second.tgt);
-            }
-
-            if (current != &root) {
-                delete current;
-            }
-        }
+        arena.release();
+        root.g.clear();
+        root.colors.reset();
+        root.count = 0;
     }
 
 
@@ -0,0 +1,409 @@
+#include "../include/MappedSuffixTree.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace aed::structure {
+
+    using Index = MappedSuffixTree::Index;
+    using LoadStatus = MappedSuffixTree::LoadStatus;
+
+    MappedSuffixTree::MappedSuffixTree()
+        : base(nullptr), size(0), header(nullptr), text(nullptr), string_offsets(nullptr),
+          nodes(nullptr), edges(nullptr), shared(nullptr), colors(nullptr) {}
+
+    MappedSuffixTree::~MappedSuffixTree() {
+        close();
+    }
+
+    // =====================================================
+    //          MAPEO DEL ARCHIVO
+    // =====================================================
+
+    /**
+     * open - Mapea un archivo escrito por SuffixTree::save
+     *
+     * Siempre valida el header y los límites de cada sección, que cuesta
+     * O(1). Lo demás es opcional porque obliga a traer páginas a memoria:
+     *
+     *  - verify_checksum recorre todo el archivo una vez y detecta
+     *    corrupción accidental (BadChecksum).
+     *  - verify_indices (validate_indices) recorre nodos, aristas, shared
+     *    y colores, O(nodos + aristas + sufijos), y garantiza que ningún
+     *    índice apunte fuera de su sección aunque el checksum coincida
+     *    (un archivo armado a mano, o abierto sin checksum).
+     *
+     * Sin verify_indices las consultas confían en los índices del archivo:
+     * uno corrupto que no se detecte puede leer fuera del mapeo. Para
+     * archivos de origen no confiable conviene pedir ambas verificaciones.
+     */
+    LoadStatus MappedSuffixTree::open(const std::string& path, bool verify_checksum, bool verify_indices) {
+        close();
+
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return LoadStatus::OpenFailed;
+        }
+        LARGE_INTEGER file_size;
+        HANDLE mapping = nullptr;
+        if (GetFileSizeEx(file, &file_size) and file_size.QuadPart > 0) {
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        }
+        CloseHandle(file);
+        if (mapping == nullptr) {
+            return LoadStatus::OpenFailed;
+        }
+        // La vista mantiene vivo el mapeo
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (view == nullptr) {
+            return LoadStatus::OpenFailed;
+        }
+        base = view;
+        size = static_cast<std::size_t>(file_size.QuadPart);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return LoadStatus::OpenFailed;
+        }
+        struct stat st;
+        void* view = MAP_FAILED;
+        if (fstat(fd, &st) == 0 and st.st_size > 0) {
+            view = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        }
+        ::close(fd);
+        if (view == MAP_FAILED) {
+            return LoadStatus::OpenFailed;
+        }
+        base = view;
+        size = static_cast<std::size_t>(st.st_size);
+#endif
+
+        LoadStatus status = validate(verify_checksum);
+        if (status == LoadStatus::Ok) {
+            const char* bytes = static_cast<const char*>(base);
+            header = static_cast<const flat::Header*>(base);
+            text = bytes + header->sections[flat::TEXT].offset;
+            string_offsets = reinterpret_cast<const std::int32_t*>(bytes + header->sections[flat::STRING_OFFSETS].offset);
+            nodes = reinterpret_cast<const flat::Node*>(bytes + header->sections[flat::NODES].offset);
+            edges = reinterpret_cast<const flat::Edge*>(bytes + header->sections[flat::EDGES].offset);
+            shared = reinterpret_cast<const flat::Shared*>(bytes + header->sections[flat::SHARED].offset);
+            colors = reinterpret_cast<const std::int32_t*>(bytes + header->sections[flat::COLORS].offset);
+            if (verify_indices) {
+                status = validate_indices();
+            }
+        }
+        if (status != LoadStatus::Ok) {
+            close();
+        }
+        return status;
+    }
+
+    /**
+     * validate - Verifica header, secciones y (opcional) checksum del mapeo
+     */
+    LoadStatus MappedSuffixTree::validate(bool verify_checksum) const {
+        if (size < sizeof(flat::Header)) {
+            return LoadStatus::BadMagic;
+        }
+        const flat::Header* h = static_cast<const flat::Header*>(base);
+        if (std::memcmp(h->magic, flat::MAGIC, sizeof(flat::MAGIC)) != 0) {
+            return LoadStatus::BadMagic;
+        }
+        if (h->version != flat::VERSION or h->endian_tag != flat::ENDIAN_TAG) {
+            return LoadStatus::BadVersion;
+        }
+        if (h->header_size != sizeof(flat::Header) or h->node_size != sizeof(flat::Node) or
+            h->edge_size != sizeof(flat::Edge) or h->file_size != size) {
+            return LoadStatus::BadLayout;
+        }
+
+        const std::size_t element_size[flat::SECTION_COUNT] = {
+            sizeof(char), sizeof(std::int32_t), sizeof(flat::Node),
+            sizeof(flat::Edge), sizeof(flat::Shared), sizeof(std::int32_t)
+        };
+        for (int s = 0; s < flat::SECTION_COUNT; ++s) {
+            const flat::Section& sec = h->sections[s];
+            if (sec.offset % 8 != 0 or sec.offset < sizeof(flat::Header) or sec.offset > size or
+                sec.count > (size - sec.offset) / element_size[s]) {
+                return LoadStatus::BadLayout;
+            }
+        }
+        if (h->sections[flat::NODES].count == 0 or
+            h->sections[flat::STRING_OFFSETS].count != std::uint64_t{h->string_count} + 1) {
+            return LoadStatus::BadLayout;
+        }
+
+        if (verify_checksum) {
+            flat::Checksum sum;
+            sum.update(static_cast<const char*>(base) + sizeof(flat::Header), size - sizeof(flat::Header));
+            if (sum.value() != h->checksum) {
+                return LoadStatus::BadChecksum;
+            }
+        }
+        return LoadStatus::Ok;
+    }
+
+    /**
+     * validate_indices - Verifica que todo índice que siguen las consultas
+     * caiga dentro de su sección
+     *
+     *  - string_offsets crecientes, desde 0 y dentro de text.
+     *  - Cada nodo: sus aristas, su subárbol (pre-order) y sus colores
+     *    dentro de sus secciones, y documents entre 0 y string_count; en
+     *    hojas, string y sufijo válidos.
+     *  - Cada color: un ID de string válido (0-based).
+     *  - Cada arista: destino dentro del subárbol del nodo, más profundo
+     *    que él, y etiqueta dentro de text.
+     *  - Cada lista de Shared de una hoja: string y posición válidos, y sin
+     *    ciclos ni entradas compartidas con otra lista. Las entradas libres
+     *    (de strings removidos) no se recorren ni se verifican.
+     */
+    LoadStatus MappedSuffixTree::validate_indices() const {
+        const flat::Section* sec = header->sections;
+        std::int64_t text_size = static_cast<std::int64_t>(sec[flat::TEXT].count);
+        std::int64_t node_count = static_cast<std::int64_t>(sec[flat::NODES].count);
+        std::int64_t edge_count = static_cast<std::int64_t>(sec[flat::EDGES].count);
+        std::int64_t shared_count = static_cast<std::int64_t>(sec[flat::SHARED].count);
+        std::int64_t color_count = static_cast<std::int64_t>(sec[flat::COLORS].count);
+        std::int64_t strings = header->string_count;
+
+        if (string_offsets[0] != 0) {
+            return LoadStatus::BadLayout;
+        }
+        for (std::int64_t id = 1; id <= strings; ++id) {
+            if (string_offsets[id] < string_offsets[id - 1] or string_offsets[id] > text_size) {
+                return LoadStatus::BadLayout;
+            }
+        }
+        // Posición de un sufijo de string_id dentro de su rango en text
+        auto valid_start = [&](std::int64_t string_id, std::int64_t start) {
+            return string_id >= 1 and string_id <= strings and
+                   start >= string_offsets[string_id - 1] and start < string_offsets[string_id];
+        };
+
+        // Shared ya alcanzados desde alguna hoja
+        std::vector<bool> visited(static_cast<std::size_t>(shared_count), false);
+        auto valid_list = [&](std::int64_t e) {
+            for (; e != -1; e = shared[e].next) {
+                if (e < 0 or e >= shared_count or visited[e] or !valid_start(shared[e].string_id, shared[e].start)) {
+                    return false;
+                }
+                visited[e] = true;
+            }
+            return true;
+        };
+
+        for (std::int64_t i = 0; i < node_count; ++i) {
+            const flat::Node& n = nodes[i];
+            if (n.first_edge < 0 or n.edge_count < 0 or
+                std::int64_t{n.first_edge} + n.edge_count > edge_count or
+                n.subtree_end <= i or n.subtree_end > node_count or
+                n.color_begin < 0 or n.color_count < 0 or
+                std::int64_t{n.color_begin} + n.color_count > color_count or
+                n.documents < 0 or n.documents > strings) {
+                return LoadStatus::BadLayout;
+            }
+            if (n.string_id != 0 and (!valid_start(n.string_id, n.suffix_start) or !valid_list(n.shared))) {
+                return LoadStatus::BadLayout;
+            }
+            for (std::int32_t j = 0; j < n.edge_count; ++j) {
+                const flat::Edge& e = edges[n.first_edge + j];
+                if (e.target <= i or e.target >= n.subtree_end) {
+                    return LoadStatus::BadLayout;
+                }
+                std::int64_t len = std::int64_t{nodes[e.target].depth} - n.depth;
+                if (len <= 0 or e.label < 0 or e.label + len > text_size) {
+                    return LoadStatus::BadLayout;
+                }
+            }
+        }
+        for (std::int64_t i = 0; i < color_count; ++i) {
+            if (colors[i] < 0 or colors[i] >= strings) {
+                return LoadStatus::BadLayout;
+            }
+        }
+        return LoadStatus::Ok;
+    }
+
+    void MappedSuffixTree::close() {
+        if (base != nullptr) {
+#ifdef _WIN32
+            UnmapViewOfFile(base);
+#else
+            munmap(base, size);
+#endif
+        }
+        base = nullptr;
+        size = 0;
+        header = nullptr;
+        text = nullptr;
+        string_offsets = nullptr;
+        nodes = nullptr;
+        edges = nullptr;
+        shared = nullptr;
+        colors = nullptr;
+    }
+
+    bool MappedSuffixTree::is_open() const {
+        return base != nullptr;
+    }
+
+    // =====================================================
+    //          CONSULTAS
+    // =====================================================
+
+    bool MappedSuffixTree::contains_end_token(std::string_view str) const {
+        return str.find(static_cast<char>(header->end_token)) != std::string_view::npos;
+    }
+
+    /**
+     * find_edge - Arista de node que empieza con c (búsqueda binaria)
+     */
+    const flat::Edge* MappedSuffixTree::find_edge(const flat::Node* node, char c) const {
+        const flat::Edge* first = edges + node->first_edge;
+        const flat::Edge* last = first + node->edge_count;
+        const flat::Edge* it = std::lower_bound(first, last, c, [](const flat::Edge& e, char x) {
+            return static_cast<unsigned char>(e.c) < static_cast<unsigned char>(x);
+        });
+        return (it != last and it->c == c) ? it : nullptr;
+    }
+
+    /**
+     * find_locus - Igual que SuffixTree::find_locus sobre el formato plano
+     */
+    const flat::Node* MappedSuffixTree::find_locus(std::string_view pattern, Index* next) const {
+        const flat::Node* node = nodes;
+        Index k = 0;
+        Index m = static_cast<Index>(pattern.size());
+        if (next != nullptr) {
+            *next = -1;
+        }
+
+        while (k < m) {
+            const flat::Edge* e = find_edge(node, pattern[k]);
+            if (e == nullptr) {
+                return nullptr;
+            }
+            const flat::Node* child = nodes + e->target;
+            Index len = child->depth - node->depth;
+            const char* label = text + e->label;
+            for (Index i = 1; i < len and k + i < m; ++i) {
+                if (pattern[k + i] != label[i]) {
+                    return nullptr;
+                }
+            }
+            if (next != nullptr and k + len > m) {
+                *next = e->label + (m - k);
+            }
+            k += len;
+            node = child;
+        }
+        return node;
+    }
+
+    bool MappedSuffixTree::is_suffix(std::string_view str) const {
+        if (!is_open() or contains_end_token(str)) {
+            return false;
+        }
+        char end_token = static_cast<char>(header->end_token);
+        Index next;
+        const flat::Node* locus = find_locus(str, &next);
+        if (locus == nullptr) {
+            return false;
+        }
+        if (next >= 0) {
+            return text[next] == end_token;
+        }
+        return find_edge(locus, end_token) != nullptr;
+    }
+
+    bool MappedSuffixTree::is_substring(std::string_view str) const {
+        if (!is_open() or contains_end_token(str)) {
+            return false;
+        }
+        return find_locus(str) != nullptr;
+    }
+
+    int MappedSuffixTree::count(std::string_view pattern) const {
+        if (!is_open() or pattern.empty() or contains_end_token(pattern)) {
+            return 0;
+        }
+        const flat::Node* locus = find_locus(pattern);
+        return locus == nullptr ? 0 : locus->count;
+    }
+
+    int MappedSuffixTree::document_frequency(std::string_view pattern) const {
+        if (!is_open() or pattern.empty() or contains_end_token(pattern)) {
+            return 0;
+        }
+        const flat::Node* locus = find_locus(pattern);
+        return locus == nullptr ? 0 : locus->documents;
+    }
+
+    /**
+     * documents - IDs de los strings que contienen pattern, ordenados
+     *
+     * Solo las hojas guardan colores: se unen los de las hojas del
+     * subárbol del locus (un rango contiguo, como en find_all), así que es
+     * O(m + tamaño del subárbol + string_count) en vez de O(m + resultado).
+     */
+    std::vector<int> MappedSuffixTree::documents(std::string_view pattern) const {
+        std::vector<int> result;
+        if (!is_open() or pattern.empty() or contains_end_token(pattern)) {
+            return result;
+        }
+        const flat::Node* locus = find_locus(pattern);
+        if (locus == nullptr) {
+            return result;
+        }
+        std::vector<bool> seen(header->string_count, false);
+        const flat::Node* end = nodes + locus->subtree_end;
+        for (const flat::Node* n = locus; n != end; ++n) {
+            for (std::int32_t i = 0; i < n->color_count; ++i) {
+                seen[colors[n->color_begin + i]] = true;
+            }
+        }
+        result.reserve(locus->documents);
+        for (std::size_t c = 0; c < seen.size(); ++c) {
+            if (seen[c]) {
+                result.push_back(static_cast<int>(c) + 1);
+            }
+        }
+        return result;
+    }
+
+    std::vector<Occurrence> MappedSuffixTree::find_all(std::string_view pattern) const {
+        std::vector<Occurrence> result;
+        find_all(pattern, [&](const Occurrence& occ) {
+            result.push_back(occ);
+        });
+        return result;
+    }
+
+    int MappedSuffixTree::get_string_count() const {
+        return is_open() ? static_cast<int>(header->string_count) : 0;
+    }
+
+    std::string_view MappedSuffixTree::get_string(int id) const {
+        // Los strings quitados antes de save() tienen rango vacío
+        if (id <= 0 or id > get_string_count() or string_offsets[id] == string_offsets[id - 1]) {
+            return {};
+        }
+        Index begin = string_offsets[id - 1];
+        Index end = string_offsets[id] - 1;  // excluir END_TOKEN
+        return std::string_view(text + begin, end - begin);
+    }
+
+
+} // namespace aed::structure
@@ -0,0 +1,164 @@
+#include "../include/RegexNfa.h"
+#include <string>
+
+namespace aed::structure {
+
+    using Mask = RegexNfa::Mask;
+
+    namespace {
+
+        constexpr std::string_view SPECIAL = ".?[]*+{}\\";
+
+        // Lee un entero no negativo desde pos; -1 si no hay dígitos
+        int parse_count(std::string_view s, std::size_t& pos) {
+            int value = -1;
+            while (pos < s.size() and s[pos] >= '0' and s[pos] <= '9') {
+                value = (value < 0 ? 0 : value * 10) + (s[pos++] - '0');
+                if (value > RegexNfa::MAX_POSITIONS) {
+                    return -1;
+                }
+            }
+            return value;
+        }
+
+    } // namespace
+
+    RegexNfa::RegexNfa() : chars{}, optional(0), before(0), last(0), length(0) {}
+
+    /**
+     * compile - Traduce regex al autómata (ver la sintaxis en RegexNfa.h)
+     *
+     * @param max_gap: repeticiones máximas de `*` y `+`
+     * @return false si regex es inválida, reconoce el string vacío o pasa
+     *         de MAX_POSITIONS posiciones; el autómata queda inválido
+     */
+    bool RegexNfa::compile(std::string_view regex, int max_gap) {
+        *this = RegexNfa();
+        bool ok = max_gap >= 0;
+        std::size_t pos = 0;
+
+        while (ok and pos < regex.size()) {
+            // Elemento: conjunto de caracteres que acepta
+            std::array<bool, 256> accepted{};
+            char c = regex[pos++];
+            if (c == '.' or c == '?') {
+                accepted.fill(true);
+            } else if (c == '[') {
+                bool negate = pos < regex.size() and regex[pos] == '^';
+                pos += negate;
+                bool empty = true;
+                while (ok and pos < regex.size() and (regex[pos] != ']' or empty)) {
+                    unsigned char from = regex[pos] == '\\' and pos + 1 < regex.size() ? regex[++pos] : regex[pos];
+                    unsigned char to = from;
+                    ++pos;
+                    if (pos + 1 < regex.size() and regex[pos] == '-' and regex[pos + 1] != ']') {
+                        to = static_cast<unsigned char>(regex[pos + 1]);
+                        pos += 2;
+                        ok = from <= to;
+                    }
+                    for (int x = from; x <= to; ++x) {
+                        accepted[x] = true;
+                    }
+                    empty = false;
+                }
+                ok = ok and pos < regex.size();
+                ++pos;
+                if (negate) {
+                    for (bool& a : accepted) {
+                        a = !a;
+                    }
+                }
+            } else if (c == '\\') {
+                ok = pos < regex.size();
+                if (ok) {
+                    accepted[static_cast<unsigned char>(regex[pos++])] = true;
+                }
+            } else {
+                ok = SPECIAL.find(c) == std::string_view::npos;
+                accepted[static_cast<unsigned char>(c)] = true;
+            }
+
+            // Cuantificador opcional
+            int min = 1, max = 1;
+            if (ok and pos < regex.size()) {
+                if (regex[pos] == '*' or regex[pos] == '+') {
+                    min = regex[pos++] == '+';
+                    max = max_gap;
+                } else if (regex[pos] == '{') {
+                    ++pos;
+                    min = max = parse_count(regex, pos);
+                    if (pos < regex.size() and regex[pos] == ',') {
+                        ++pos;
+                        max = parse_count(regex, pos);
+                    }
+                    ok = min >= 0 and max >= min and pos < regex.size() and regex[pos] == '}';
+                    ++pos;
+                }
+            }
+            ok = ok and max >= min and length + max <= MAX_POSITIONS;
+
+            // Copias: min obligatorias y max - min opcionales
+            for (int copy = 0; ok and copy < max; ++copy) {
+                Mask bit = Mask{1} << ++length;
+                for (int x = 0; x < 256; ++x) {
+                    if (accepted[x]) {
+                        chars[x] |= bit;
+                    }
+                }
+                if (copy >= min) {
+                    if (!(optional & (bit >> 1))) {
+                        before |= bit >> 1;
+                    }
+                    last = (last & ~(bit >> 1)) | bit;
+                    optional |= bit;
+                }
+            }
+        }
+
+        if (!ok or length == 0 or accepts(start())) {
+            *this = RegexNfa();
+            return false;
+        }
+        return true;
+    }
+
+    bool RegexNfa::is_valid() const {
+        return length > 0;
+    }
+
+    int RegexNfa::positions() const {
+        return length;
+    }
+
+    /**
+     * start - Estados activos antes de leer nada
+     */
+    Mask RegexNfa::start() const {
+        return closure(1);
+    }
+
+    /**
+     * step - Estados activos después de leer c (0: ya no hay match posible)
+     */
+    Mask RegexNfa::step(Mask active, char c) const {
+        return closure((active << 1) & chars[static_cast<unsigned char>(c)]);
+    }
+
+    bool RegexNfa::accepts(Mask active) const {
+        return length > 0 and (active >> length) & 1;
+    }
+
+    /**
+     * closure - Agrega los estados alcanzables saltando posiciones opcionales
+     *
+     * En cada bloque de opcionales, la resta propaga el estado activo más
+     * bajo (o el anterior al bloque) hasta el final del bloque; el bit de
+     * last corta la propagación entre bloques.
+     */
+    Mask RegexNfa::closure(Mask active) const {
+        Mask with_last = active | last;
+        return active | (optional & (~(with_last - before) ^ with_last));
+    }
+
+
+} // namespace aed::structure
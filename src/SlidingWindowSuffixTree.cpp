@@ -0,0 +1,407 @@
+#include "../include/SlidingWindowSuffixTree.h"
+#include <algorithm>
+#include <limits>
+
+namespace aed::structure {
+
+    using Position = SlidingWindowSuffixTree::Position;
+
+    // =====================================================
+    //          CONSTRUCCION
+    // =====================================================
+
+    /**
+     * Constructor - Reserva todo lo que la ventana puede llegar a usar
+     *
+     * Un árbol implícito de n caracteres tiene a lo sumo n hojas, y cada
+     * nodo interno (salvo la raíz) tiene al menos dos hijos: con la raíz
+     * son a lo sumo n nodos internos.
+     *
+     * @param window Caracteres que se mantienen indexados (al menos 1)
+     */
+    SlidingWindowSuffixTree::SlidingWindowSuffixTree(std::size_t window)
+        : capacity(std::clamp<std::size_t>(window, 1, std::numeric_limits<std::int32_t>::max() - 1)),
+          ring(std::make_unique<char[]>(capacity)),
+          leaf_parent(std::make_unique<Ref[]>(capacity)),
+          nodes(std::make_unique<Node[]>(capacity + 1)),
+          used_nodes(0) {
+        free_nodes.reserve(capacity);
+        clear();
+    }
+
+    /**
+     * clear - Vacía la ventana y vuelve a la posición 0 (conserva la reserva)
+     */
+    void SlidingWindowSuffixTree::clear() {
+        for (std::size_t v = 0; v < used_nodes; ++v) {
+            nodes[v].g.clear();
+        }
+        nodes[ROOT].depth = 0;
+        free_nodes.clear();
+        used_nodes = 1;
+        tail = 0;
+        front = 0;
+        ins = ROOT;
+        proj = 0;
+    }
+
+    /**
+     * push - Agrega un carácter al final de la ventana
+     *
+     * Con la ventana llena, primero borra el sufijo más viejo: así su
+     * casilla del buffer (y la de su hoja) queda libre para el nuevo.
+     */
+    void SlidingWindowSuffixTree::push(char c) {
+        if (size() == capacity) {
+            delete_oldest();
+        }
+        insert(c);
+    }
+
+    void SlidingWindowSuffixTree::append(std::string_view chunk) {
+        for (char c : chunk) {
+            push(c);
+        }
+    }
+
+    // =====================================================
+    //          ACCESO A NODOS Y HOJAS
+    // =====================================================
+
+    char SlidingWindowSuffixTree::at(Position p) const {
+        return ring[static_cast<std::size_t>(p % static_cast<Position>(capacity))];
+    }
+
+    SlidingWindowSuffixTree::Ref SlidingWindowSuffixTree::leaf_ref(Position start) const {
+        return -static_cast<Ref>(start % static_cast<Position>(capacity)) - 1;
+    }
+
+    /**
+     * leaf_start - Inicio del sufijo de una hoja
+     *
+     * Todas las hojas empiezan en [tail, front), un rango de a lo sumo
+     * capacity posiciones: la casilla determina la posición.
+     */
+    Position SlidingWindowSuffixTree::leaf_start(Ref leaf) const {
+        Position cap = static_cast<Position>(capacity);
+        Position slot = -static_cast<Position>(leaf) - 1;
+        return tail + (slot - tail % cap + cap) % cap;
+    }
+
+    // Inicio de un sufijo que pasa por r (hoja o nodo interno)
+    Position SlidingWindowSuffixTree::ref_pos(Ref r) const {
+        return r < 0 ? leaf_start(r) : nodes[r].pos;
+    }
+
+    // Profundidad de r: las hojas llegan hasta el final de la ventana
+    Position SlidingWindowSuffixTree::ref_depth(Ref r) const {
+        return r < 0 ? front - leaf_start(r) : nodes[r].depth;
+    }
+
+    SlidingWindowSuffixTree::Ref SlidingWindowSuffixTree::new_node() {
+        Ref v;
+        if (!free_nodes.empty()) {
+            v = free_nodes.back();
+            free_nodes.pop_back();
+        } else {
+            v = static_cast<Ref>(used_nodes++);
+        }
+        nodes[v].credit = false;
+        return v;
+    }
+
+    void SlidingWindowSuffixTree::free_node(Ref v) {
+        nodes[v].g.clear();
+        free_nodes.push_back(v);
+    }
+
+    // =====================================================
+    //          ALGORITMO (UKKONEN + LARSSON)
+    // =====================================================
+
+    /**
+     * insert - Fase de Ukkonen para el carácter c en la posición front
+     *
+     * Agrega una hoja por cada sufijo desde el punto activo hasta el
+     * primero que ya aparece seguido de c. Los nodos internos nuevos
+     * reciben su suffix link en el paso siguiente de la misma fase.
+     */
+    void SlidingWindowSuffixTree::insert(char c) {
+        Position f = front;
+        ring[static_cast<std::size_t>(f % static_cast<Position>(capacity))] = c;
+
+        Ref pending = ROOT;     // nodo interno nuevo que espera su suffix link
+        while (true) {
+            Ref r;
+            if (proj == 0) {
+                if (nodes[ins].g.find(c) != nullptr) {
+                    if (pending != ROOT) {
+                        nodes[pending].suffix_link = ins;
+                    }
+                    proj = 1;
+                    canonize(f + 1);
+                    break;
+                }
+                r = ins;
+            } else {
+                Ref w = *nodes[ins].g.find(at(f - proj));
+                if (at(ref_pos(w) + nodes[ins].depth + proj) == c) {
+                    ++proj;
+                    canonize(f + 1);
+                    break;
+                }
+                r = split(w, f);
+            }
+
+            Position start = f - nodes[r].depth;
+            nodes[r].g.set(c, leaf_ref(start));
+            leaf_parent[static_cast<std::size_t>(start % static_cast<Position>(capacity))] = r;
+            send_credit(r, start);
+
+            if (pending != ROOT) {
+                nodes[pending].suffix_link = r;
+            }
+            pending = r == ins ? ROOT : r;
+
+            // Siguiente sufijo más corto
+            if (ins == ROOT) {
+                if (proj == 0) {
+                    break;
+                }
+                --proj;
+            } else {
+                ins = nodes[ins].suffix_link;
+            }
+            canonize(f);
+        }
+        ++front;
+    }
+
+    /**
+     * split - Parte la arista ins -> w a proj caracteres de ins
+     *
+     * El nodo nuevo representa el sufijo activo, que empieza en
+     * f - depth: esa es su pos.
+     */
+    SlidingWindowSuffixTree::Ref SlidingWindowSuffixTree::split(Ref w, Position f) {
+        Ref u = new_node();
+        Node& n = nodes[u];
+        n.depth = nodes[ins].depth + proj;
+        n.pos = f - n.depth;
+        n.parent = ins;
+        n.suffix_link = ROOT;
+
+        Position label = ref_pos(w) + nodes[ins].depth;
+        nodes[ins].g.set(at(label), u);
+        n.g.set(at(label + proj), w);
+        if (w < 0) {
+            leaf_parent[static_cast<std::size_t>(-(w + 1))] = u;
+        } else {
+            nodes[w].parent = u;
+        }
+        return u;
+    }
+
+    /**
+     * canonize - Baja ins mientras los proj caracteres que terminan en end
+     * cubran la arista completa
+     *
+     * Las aristas a hojas no se cruzan nunca: el sufijo activo aparece
+     * antes, así que termina dentro de la hoja de esa aparición.
+     */
+    void SlidingWindowSuffixTree::canonize(Position end) {
+        while (proj > 0) {
+            Ref w = *nodes[ins].g.find(at(end - proj));
+            if (w < 0) {
+                return;
+            }
+            std::int32_t len = nodes[w].depth - nodes[ins].depth;
+            if (proj < len) {
+                return;
+            }
+            ins = w;
+            proj -= len;
+        }
+    }
+
+    /**
+     * delete_oldest - Borra el sufijo que empieza en tail (siempre una hoja)
+     *
+     * Si el punto activo está sobre la arista de esa hoja, su única
+     * aparición anterior era justamente la que se borra: en vez de borrar,
+     * la hoja pasa a ser el sufijo activo y el punto activo avanza al
+     * siguiente más corto. Si no, se quita la hoja y su padre se fusiona
+     * con su único hijo si quedó con uno solo.
+     */
+    void SlidingWindowSuffixTree::delete_oldest() {
+        Ref leaf = leaf_ref(tail);
+        Ref v = leaf_parent[static_cast<std::size_t>(-(leaf + 1))];
+        Node& parent = nodes[v];
+        char key = at(tail + parent.depth);
+
+        if (ins == v and proj > 0 and at(front - proj) == key) {
+            Position start = front - parent.depth - proj;
+            parent.g.set(key, leaf_ref(start));
+            leaf_parent[static_cast<std::size_t>(start % static_cast<Position>(capacity))] = v;
+            send_credit(v, start);
+            if (v == ROOT) {
+                --proj;
+            } else {
+                ins = parent.suffix_link;
+            }
+            ++tail;
+            canonize(front);
+            return;
+        }
+
+        parent.g.erase(key);
+        if (v != ROOT and parent.g.size() == 1) {
+            merge(v);
+        }
+        ++tail;
+    }
+
+    /**
+     * merge - Quita el nodo interno v, que quedó con un solo hijo
+     *
+     * El hijo cuelga directo del padre de v; su etiqueta sale de su propia
+     * pos, así que no hay que reescribir nada. Ningún suffix link apunta a
+     * v: si cα tuviera dos hijos, α también. El crédito que tenía v pasa al
+     * padre para no perder su posición.
+     */
+    void SlidingWindowSuffixTree::merge(Ref v) {
+        Node& n = nodes[v];
+        Ref child = (*n.g.begin()).second;
+        Ref u = n.parent;
+
+        nodes[u].g.set(at(ref_pos(child) + nodes[u].depth), child);
+        if (child < 0) {
+            leaf_parent[static_cast<std::size_t>(-(child + 1))] = u;
+        } else {
+            nodes[child].parent = u;
+        }
+        if (ins == v) {
+            ins = u;
+            proj += n.depth - nodes[u].depth;
+        }
+        if (n.credit) {
+            send_credit(u, n.pos);
+        }
+        free_node(v);
+    }
+
+    /**
+     * send_credit - Actualiza pos subiendo desde v con el sufijo i
+     *
+     * Cada nodo acumula un crédito: con el primero se queda (y actualiza
+     * su pos); con el segundo lo pasa al padre junto con la posición más
+     * nueva que conoce. Como un contador binario, el costo es O(1)
+     * amortizado, y alcanza para que ningún pos quede fuera de la ventana
+     * (Larsson, "Extended application of suffix trees to data
+     * compression", 1996).
+     */
+    void SlidingWindowSuffixTree::send_credit(Ref v, Position i) {
+        while (v != ROOT) {
+            Node& n = nodes[v];
+            i = std::max(i, n.pos);
+            n.pos = i;
+            n.credit = !n.credit;
+            if (n.credit) {
+                return;
+            }
+            v = n.parent;
+        }
+    }
+
+    // =====================================================
+    //          CONSULTAS
+    // =====================================================
+
+    /**
+     * find - Posición absoluta de una aparición de str en la ventana
+     *
+     * Es la pos del nodo (o la hoja) donde termina str: en general una de
+     * las apariciones más recientes, útil para referencias tipo LZ77.
+     *
+     * @return -1 si str no aparece
+     */
+    Position SlidingWindowSuffixTree::find(std::string_view str) const {
+        if (str.empty()) {
+            return tail;
+        }
+        Ref node = ROOT;
+        std::size_t i = 0;
+        while (true) {
+            const Ref* child = nodes[node].g.find(str[i]);
+            if (child == nullptr) {
+                return -1;
+            }
+            Position start = ref_pos(*child);
+            Position label = start + nodes[node].depth;
+            Position len = std::min<Position>(ref_depth(*child) - nodes[node].depth,
+                                              static_cast<Position>(str.size() - i));
+            for (Position k = 0; k < len; ++k, ++i) {
+                if (at(label + k) != str[i]) {
+                    return -1;
+                }
+            }
+            if (i == str.size()) {
+                return start;
+            }
+            if (*child < 0) {
+                return -1;
+            }
+            node = *child;
+        }
+    }
+
+    bool SlidingWindowSuffixTree::is_substring(std::string_view str) const {
+        return find(str) >= 0;
+    }
+
+    std::size_t SlidingWindowSuffixTree::window() const {
+        return capacity;
+    }
+
+    std::size_t SlidingWindowSuffixTree::size() const {
+        return static_cast<std::size_t>(front - tail);
+    }
+
+    Position SlidingWindowSuffixTree::begin_position() const {
+        return tail;
+    }
+
+    Position SlidingWindowSuffixTree::end_position() const {
+        return front;
+    }
+
+    std::string SlidingWindowSuffixTree::contents() const {
+        std::string out;
+        out.reserve(size());
+        for (Position p = tail; p < front; ++p) {
+            out.push_back(at(p));
+        }
+        return out;
+    }
+
+    // Nodos internos en uso (incluida la raiz)
+    std::size_t SlidingWindowSuffixTree::node_count() const {
+        return used_nodes - free_nodes.size();
+    }
+
+    /**
+     * memory_bytes - Memoria reservada: fija para una ventana dada, salvo
+     * los bloques de desborde de hijos
+     */
+    std::size_t SlidingWindowSuffixTree::memory_bytes() const {
+        std::size_t bytes = capacity * (sizeof(char) + sizeof(Ref))
+                          + (capacity + 1) * sizeof(Node)
+                          + free_nodes.capacity() * sizeof(Ref);
+        for (std::size_t v = 0; v < used_nodes; ++v) {
+            bytes += nodes[v].g.heap_bytes();
+        }
+        return bytes;
+    }
+
+
+} // namespace aed::structure
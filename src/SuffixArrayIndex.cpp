@@ -0,0 +1,440 @@
+#include "../include/SuffixArrayIndex.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace aed::structure {
+
+    using Index = SuffixArrayIndex::Index;
+
+    namespace {
+
+        /**
+         * Vista de text para SA-IS: cada byte se corre en 1 y se agrega un
+         * centinela 0 (unico y menor a todo) al final.
+         */
+        struct TextSymbols {
+            const std::string& text;
+            int operator[](Index i) const {
+                return i == static_cast<Index>(text.size()) ? 0 : static_cast<unsigned char>(text[i]) + 1;
+            }
+        };
+
+        // Vista de un arreglo de enteros (niveles recursivos de SA-IS)
+        struct IntSymbols {
+            const Index* s;
+            int operator[](Index i) const { return s[i]; }
+        };
+
+        /**
+         * sais - Arreglo de sufijos por induced sorting (Nong, Zhang, Chan 2009)
+         *
+         * T tiene n símbolos en [0, k], el último es el centinela 0 (único).
+         * Deja en SA los sufijos ordenados. Tiempo y memoria extra O(n + k).
+         */
+        template<typename Symbols>
+        void sais(const Symbols& T, Index* SA, Index n, Index k) {
+            // Tipo de cada sufijo: S (true) o L (false)
+            std::vector<bool> stype(n);
+            stype[n - 1] = true;
+            for (Index i = n - 2; i >= 0; --i) {
+                stype[i] = T[i] < T[i + 1] or (T[i] == T[i + 1] and stype[i + 1]);
+            }
+            auto is_lms = [&](Index i) {
+                return i > 0 and stype[i] and !stype[i - 1];
+            };
+
+            std::vector<Index> bucket(k + 1);
+            auto get_buckets = [&](bool ends) {
+                std::fill(bucket.begin(), bucket.end(), 0);
+                for (Index i = 0; i < n; ++i) {
+                    ++bucket[T[i]];
+                }
+                Index sum = 0;
+                for (Index c = 0; c <= k; ++c) {
+                    sum += bucket[c];
+                    bucket[c] = ends ? sum : sum - bucket[c];
+                }
+            };
+            auto induce = [&]() {
+                get_buckets(false);
+                for (Index i = 0; i < n; ++i) {
+                    Index j = SA[i] - 1;
+                    if (SA[i] > 0 and !stype[j]) {
+                        SA[bucket[T[j]]++] = j;
+                    }
+                }
+                get_buckets(true);
+                for (Index i = n - 1; i >= 0; --i) {
+                    Index j = SA[i] - 1;
+                    if (SA[i] > 0 and stype[j]) {
+                        SA[--bucket[T[j]]] = j;
+                    }
+                }
+            };
+
+            // 1. Ordenar los substrings LMS
+            get_buckets(true);
+            std::fill(SA, SA + n, -1);
+            for (Index i = 1; i < n; ++i) {
+                if (is_lms(i)) {
+                    SA[--bucket[T[i]]] = i;
+                }
+            }
+            induce();
+
+            // 2. Compactar los LMS ordenados y nombrarlos
+            Index m = 0;
+            for (Index i = 0; i < n; ++i) {
+                if (is_lms(SA[i])) {
+                    SA[m++] = SA[i];
+                }
+            }
+            std::fill(SA + m, SA + n, -1);
+
+            Index name = 0, prev = -1;
+            for (Index i = 0; i < m; ++i) {
+                Index pos = SA[i];
+                bool diff = false;
+                for (Index d = 0; d < n; ++d) {
+                    if (prev == -1 or T[pos + d] != T[prev + d] or stype[pos + d] != stype[prev + d]) {
+                        diff = true;
+                        break;
+                    }
+                    if (d > 0 and (is_lms(pos + d) or is_lms(prev + d))) {
+                        break;
+                    }
+                }
+                if (diff) {
+                    ++name;
+                    prev = pos;
+                }
+                SA[m + pos / 2] = name - 1;
+            }
+            for (Index i = n - 1, j = n - 1; i >= m; --i) {
+                if (SA[i] >= 0) {
+                    SA[j--] = SA[i];
+                }
+            }
+
+            // 3. Ordenar los sufijos LMS (recursión si hay nombres repetidos)
+            Index* s1 = SA + n - m;
+            if (name < m) {
+                sais(IntSymbols{s1}, SA, m, name - 1);
+            } else {
+                for (Index i = 0; i < m; ++i) {
+                    SA[s1[i]] = i;
+                }
+            }
+
+            // 4. Inducir el orden de todos los sufijos desde los LMS
+            for (Index i = 1, j = 0; i < n; ++i) {
+                if (is_lms(i)) {
+                    s1[j++] = i;
+                }
+            }
+            for (Index i = 0; i < m; ++i) {
+                SA[i] = s1[SA[i]];
+            }
+            std::fill(SA + m, SA + n, -1);
+            get_buckets(true);
+            for (Index i = m - 1; i >= 0; --i) {
+                Index j = SA[i];
+                SA[i] = -1;
+                SA[--bucket[T[j]]] = j;
+            }
+            induce();
+        }
+
+    } // namespace
+
+
+    SuffixArrayIndex::SuffixArrayIndex() : string_offsets{0}, built(true) {}
+
+    /**
+     * clear - Elimina todos los strings y los arreglos
+     */
+    void SuffixArrayIndex::clear() {
+        text.clear();
+        string_offsets.assign(1, 0);
+        sa.clear();
+        lcp.clear();
+        built = true;
+    }
+
+    /**
+     * add_string - Agrega str + END_TOKEN al texto
+     *
+     * @return ID del string, o -1 si contiene END_TOKEN o el texto
+     *         excedería el rango de Index
+     */
+    int SuffixArrayIndex::add_string(std::string_view str) {
+        if (str.find(END_TOKEN) != std::string_view::npos) {
+            return -1;
+        }
+        // +1 por END_TOKEN y +1 por el centinela de SA-IS
+        if (text.size() + str.size() + 2 > static_cast<std::size_t>(std::numeric_limits<Index>::max())) {
+            return -1;
+        }
+        text.append(str);
+        text.push_back(END_TOKEN);
+        string_offsets.push_back(static_cast<Index>(text.size()));
+        built = false;
+        return get_string_count();
+    }
+
+    /**
+     * build - Construye SA y LCP si hubo strings nuevos. Hace falta antes
+     * de consultar
+     */
+    void SuffixArrayIndex::build() {
+        if (built) {
+            return;
+        }
+        build_suffix_array();
+        build_lcp();
+        built = true;
+    }
+
+    bool SuffixArrayIndex::is_built() const {
+        return built;
+    }
+
+    void SuffixArrayIndex::build_suffix_array() {
+        Index n = static_cast<Index>(text.size());
+        // Un lugar extra para el centinela, que queda primero y se descarta
+        sa.assign(n + 1, 0);
+        sais(TextSymbols{text}, sa.data(), n + 1, 256);
+        sa.erase(sa.begin());
+        sa.shrink_to_fit();
+    }
+
+    /**
+     * build_lcp - Kasai et al. con comparación cortada en END_TOKEN
+     *
+     * Se recorre text en orden: el LCP de la posición p+1 es al menos el de
+     * p menos 1, salvo al cruzar un END_TOKEN, donde empieza otro string y
+     * se reinicia en 0.
+     */
+    void SuffixArrayIndex::build_lcp() {
+        Index n = static_cast<Index>(text.size());
+        std::vector<Index> rank(n);
+        for (Index i = 0; i < n; ++i) {
+            rank[sa[i]] = i;
+        }
+
+        lcp.assign(n, 0);
+        Index h = 0;
+        for (Index p = 0; p < n; ++p) {
+            if (rank[p] > 0) {
+                Index q = sa[rank[p] - 1];
+                while (p + h < n and q + h < n and text[p + h] == text[q + h] and text[p + h] != END_TOKEN) {
+                    ++h;
+                }
+                // Ambos llegan juntos al END_TOKEN: es el mismo sufijo del GST
+                bool same_end = p + h < n and q + h < n and text[p + h] == END_TOKEN and text[q + h] == END_TOKEN;
+                lcp[rank[p]] = h + (same_end ? 1 : 0);
+            } else {
+                h = 0;
+            }
+
+            if (text[p] == END_TOKEN) {
+                h = 0;
+            } else if (h > 0) {
+                --h;
+            }
+        }
+    }
+
+
+    /**
+     * compare_suffix - Compara el sufijo en pos con pattern
+     *
+     * Solo se miran los primeros |pattern| caracteres (más un END_TOKEN
+     * virtual si with_end), como unsigned char igual que en el orden de SA.
+     *
+     * @return <0 si el sufijo es menor, 0 si pattern es prefijo, >0 si es mayor
+     */
+    int SuffixArrayIndex::compare_suffix(Index pos, std::string_view pattern, bool with_end) const {
+        Index n = static_cast<Index>(text.size());
+        Index m = static_cast<Index>(pattern.size()) + (with_end ? 1 : 0);
+        for (Index k = 0; k < m; ++k) {
+            if (pos + k >= n) {
+                return -1;
+            }
+            unsigned char a = text[pos + k];
+            unsigned char b = k < static_cast<Index>(pattern.size()) ? pattern[k] : END_TOKEN;
+            if (a != b) {
+                return a < b ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * find_range - Rango [lo, hi) de SA cuyos sufijos empiezan con pattern
+     *
+     * Dos búsquedas binarias: O(m log n).
+     */
+    std::pair<Index, Index> SuffixArrayIndex::find_range(std::string_view pattern, bool with_end) const {
+        auto lo = std::lower_bound(sa.begin(), sa.end(), 0, [&](Index pos, int) {
+            return compare_suffix(pos, pattern, with_end) < 0;
+        });
+        auto hi = std::upper_bound(lo, sa.end(), 0, [&](int, Index pos) {
+            return compare_suffix(pos, pattern, with_end) > 0;
+        });
+        return {static_cast<Index>(lo - sa.begin()), static_cast<Index>(hi - sa.begin())};
+    }
+
+
+    /**
+     * is_substring / is_suffix - false sin build() después del último add_string
+     */
+    bool SuffixArrayIndex::is_substring(std::string_view str) const {
+        if (!built or str.find(END_TOKEN) != std::string_view::npos) {
+            return false;
+        }
+        if (str.empty()) {
+            return true;
+        }
+        auto [lo, hi] = find_range(str, false);
+        return lo < hi;
+    }
+
+    bool SuffixArrayIndex::is_suffix(std::string_view str) const {
+        if (!built or str.find(END_TOKEN) != std::string_view::npos) {
+            return false;
+        }
+        auto [lo, hi] = find_range(str, true);
+        return lo < hi;
+    }
+
+
+    /**
+     * distinguishing_substrings - Substrings más cortos exclusivos de cada string
+     *
+     * Para cada string devuelve sus substrings de largo mínimo que no
+     * aparecen en ningún otro string (uno por substring distinto, con su
+     * primera posición). Un string contenido en otro no tiene ninguno.
+     *
+     * Para el sufijo en sa[i] del string d, sea L el mayor LCP con un sufijo
+     * de otro string: su prefijo de largo L + 1 es exclusivo de d, y es el
+     * más corto que empieza ahí. L sale del mínimo de lcp hasta el vecino
+     * más cercano (arriba y abajo) de otro string, en dos barridos lineales.
+     *
+     * @return triples (string_id, offset, length) ordenados por string y
+     *         offset; vacío sin build() después del último add_string
+     */
+    std::vector<SubstringRef> SuffixArrayIndex::distinguishing_substrings() const {
+        if (!built) {
+            return {};
+        }
+        Index n = static_cast<Index>(text.size());
+        int strings = get_string_count();
+
+        // doc[i] = string del sufijo sa[i]
+        std::vector<int> doc(n);
+        {
+            std::vector<int> by_pos(n);
+            for (int id = 1; id <= strings; ++id) {
+                std::fill(by_pos.begin() + string_offsets[id - 1], by_pos.begin() + string_offsets[id], id);
+            }
+            for (Index i = 0; i < n; ++i) {
+                doc[i] = by_pos[sa[i]];
+            }
+        }
+
+        // best[i]: LCP máximo con otro string (-1 si no hay ninguno de ese lado)
+        std::vector<Index> best(n, -1);
+        for (Index i = 1, up = -1; i < n; ++i) {
+            if (doc[i - 1] != doc[i]) {
+                up = lcp[i];
+            } else if (up >= 0) {
+                up = std::min(up, lcp[i]);
+            }
+            best[i] = up;
+        }
+        for (Index i = n - 2, down = -1; i >= 0; --i) {
+            if (doc[i + 1] != doc[i]) {
+                down = lcp[i + 1];
+            } else if (down >= 0) {
+                down = std::min(down, lcp[i + 1]);
+            }
+            best[i] = std::max(best[i], down);
+        }
+
+        // Largo mínimo por string; el prefijo no puede incluir END_TOKEN
+        std::vector<Index> shortest(strings + 1, std::numeric_limits<Index>::max());
+        for (Index i = 0; i < n; ++i) {
+            best[i] = std::max<Index>(best[i], 0) + 1;
+            int d = doc[i];
+            if (best[i] <= string_offsets[d] - 1 - sa[i]) {
+                shortest[d] = std::min(shortest[d], best[i]);
+            } else {
+                best[i] = 0;
+            }
+        }
+
+        // Los sufijos con el mismo prefijo exclusivo son contiguos en SA:
+        // se reporta uno por bloque, con la menor posición
+        std::vector<SubstringRef> result;
+        for (Index i = 0; i < n; ++i) {
+            int d = doc[i];
+            if (best[i] != shortest[d]) {
+                continue;
+            }
+            Index offset = sa[i] - string_offsets[d - 1];
+            if (i > 0 and lcp[i] >= best[i] and !result.empty()) {
+                result.back().offset = std::min(result.back().offset, offset);
+                continue;
+            }
+            result.push_back({d, offset, best[i]});
+        }
+
+        std::sort(result.begin(), result.end(), [](const SubstringRef& a, const SubstringRef& b) {
+            return a.string_id != b.string_id ? a.string_id < b.string_id : a.offset < b.offset;
+        });
+        return result;
+    }
+
+
+    int SuffixArrayIndex::get_string_count() const {
+        return static_cast<int>(string_offsets.size()) - 1;
+    }
+
+    /**
+     * get_string - Vista (sin copia) del string id, sin el END_TOKEN
+     */
+    std::string_view SuffixArrayIndex::get_string(int id) const {
+        if (id <= 0 or id > get_string_count()) {
+            return {};
+        }
+        Index begin = string_offsets[id - 1];
+        Index end = string_offsets[id] - 1;  // excluir END_TOKEN
+        return std::string_view(text).substr(begin, end - begin);
+    }
+
+    /**
+     * memory_bytes - Memoria reservada por texto, SA y LCP
+     */
+    std::size_t SuffixArrayIndex::memory_bytes() const {
+        return text.capacity()
+             + string_offsets.capacity() * sizeof(Index)
+             + sa.capacity() * sizeof(Index)
+             + lcp.capacity() * sizeof(Index);
+    }
+
+    /**
+     * suffix_array / lcp_array - Los arreglos de la última build() (vacíos
+     * o viejos si hubo strings nuevos después; ver is_built)
+     */
+    const std::vector<Index>& SuffixArrayIndex::suffix_array() const {
+        return sa;
+    }
+
+    const std::vector<Index>& SuffixArrayIndex::lcp_array() const {
+        return lcp;
+    }
+
+
+} // namespace aed::structure
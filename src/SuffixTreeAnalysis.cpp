@@ -0,0 +1,256 @@
+#include "../include/SuffixTree.h"
+#include "../include/TreeTraversal.h"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace aed::structure {
+
+    using Node       = SuffixTree::Node;
+    using Transition = SuffixTree::Transition;
+    using Index      = SuffixTree::Index;
+
+    // =====================================================
+    //          DISTINGUISHING SUBSTRINGS (DSus)
+    // =====================================================
+
+    /**
+     * distinguishing_substrings - Substrings más cortos exclusivos de cada string
+     *
+     * Misma salida que SuffixArrayIndex::distinguishing_substrings: para
+     * cada string, sus substrings de largo mínimo que no aparecen en ningún
+     * otro (uno por substring distinto, con su primera posición). Un string
+     * contenido en otro no tiene ninguno.
+     *
+     * Un substring es exclusivo de d si todo el subárbol de su locus es de
+     * d. Con v de un solo string y su padre u de varios (o la raíz), los
+     * exclusivos que terminan en la arista u -> v miden de depth(u) + 1 en
+     * adelante: el candidato es el primer carácter de la arista (si no es
+     * END_TOKEN), y su primera posición es el menor inicio de las hojas de v.
+     *
+     * Un solo post-order calcula, por subárbol, su único string (o si hay
+     * varios) y el menor inicio, con O(1) por nodo. No usa los ColorSet,
+     * así que no depende de compute_colors y es const.
+     *
+     * @return triples (string_id, offset, length) ordenados por string y
+     *         offset; vacío con un string abierto (begin_string)
+     */
+    std::vector<SubstringRef> SuffixTree::distinguishing_substrings() const {
+        if (stream_id != 0) {
+            return {};
+        }
+        constexpr int NONE = 0;
+        constexpr int SEVERAL = -1;
+
+        // Un marco por nodo abierto del recorrido
+        struct Frame {
+            int owner;              // NONE, SEVERAL o el ID del único string
+            Index first;            // menor inicio (global) de sus hojas
+            std::size_t candidates; // tamaño de candidates al entrar
+        };
+        std::vector<Frame> open;
+        std::vector<SubstringRef> candidates;
+
+        DepthFirst<const Node>().run(&tree.root,
+            [&](const Node* n, const Transition*) {
+                Frame f{NONE, std::numeric_limits<Index>::max(), candidates.size()};
+                if (n->leaf) {
+                    f.owner = n->shared >= 0 ? SEVERAL : n->string_id;
+                    f.first = n->suffix_start;
+                }
+                open.push_back(f);
+                return true;
+            },
+            [&](const Node* n, const Transition* trans) {
+                Frame f = open.back();
+                open.pop_back();
+                if (trans == nullptr) {
+                    return;
+                }
+
+                // Todo el subárbol es de un solo string: ningún descendiente
+                // es candidato (sus padres tampoco tienen varios), solo n
+                if (f.owner > 0) {
+                    candidates.resize(f.candidates);
+                    if (text[trans->sub.l] != END_TOKEN) {
+                        candidates.push_back({f.owner, f.first - string_offsets[f.owner - 1],
+                                              n->parent->depth + 1});
+                    }
+                }
+
+                Frame& up = open.back();
+                up.owner = up.owner == NONE or up.owner == f.owner ? f.owner : SEVERAL;
+                up.first = std::min(up.first, f.first);
+            });
+
+        // Solo quedan los de largo mínimo de cada string
+        std::vector<Index> shortest(last_index + 1, std::numeric_limits<Index>::max());
+        for (const SubstringRef& c : candidates) {
+            shortest[c.string_id] = std::min(shortest[c.string_id], c.length);
+        }
+        std::vector<SubstringRef> result;
+        for (const SubstringRef& c : candidates) {
+            if (c.length == shortest[c.string_id]) {
+                result.push_back(c);
+            }
+        }
+
+        std::sort(result.begin(), result.end(), [](const SubstringRef& a, const SubstringRef& b) {
+            return a.string_id != b.string_id ? a.string_id < b.string_id : a.offset < b.offset;
+        });
+        return result;
+    }
+
+
+    // =====================================================
+    //          LONGEST COMMON SUBSTRING (k de N)
+    // =====================================================
+
+    /**
+     * longest_common_substring - Substrings más largos presentes en al
+     * menos k strings distintos
+     *
+     * No recalcula colores: vacío si no están al día (ver compute_colors;
+     * siempre lo están después de freeze) o hay un string abierto
+     * (begin_string).
+     *
+     * Un substring está en k strings si su locus tiene al menos k colores,
+     * así que la respuesta son los nodos con count() >= k de mayor depth.
+     * Una hoja cuenta con depth - 1 (sin el END_TOKEN), salvo si su arista
+     * es solo END_TOKEN: su etiqueta sin él es la del padre.
+     *
+     * Un post-order calcula el menor inicio de cada subárbol para dar una
+     * aparición de cada resultado (la primera: menor string y offset).
+     * O(#nodos), sin copiar strings.
+     *
+     * @param k: cantidad mínima de strings (1 da los strings más largos)
+     * @return un SubstringRef por substring distinto de largo máximo,
+     *         ordenados por string y offset; vacío si ninguno tiene largo > 0
+     */
+    std::vector<SubstringRef> SuffixTree::longest_common_substring(int k) const {
+        if (!colors_computed or stream_id != 0 or k <= 0) {
+            return {};
+        }
+
+        // Primera aparición (menor inicio global) de cada nodo abierto
+        std::vector<Occurrence> first;
+        std::vector<SubstringRef> result;
+        Index best = 0;
+
+        DepthFirst<const Node>().run(&tree.root,
+            [&](const Node* n, const Transition*) {
+                Occurrence occ{0, std::numeric_limits<Index>::max()};
+                if (n->leaf) {
+                    occ = {n->string_id, n->suffix_start};
+                    for (Index e = n->shared; e >= 0; e = shared_suffixes[e].next) {
+                        if (shared_suffixes[e].start < occ.offset) {
+                            occ = {shared_suffixes[e].string_id, shared_suffixes[e].start};
+                        }
+                    }
+                }
+                first.push_back(occ);
+                return true;
+            },
+            [&](const Node* n, const Transition* trans) {
+                Occurrence occ = first.back();
+                first.pop_back();
+                if (trans == nullptr) {
+                    return;
+                }
+                if (occ.offset < first.back().offset) {
+                    first.back() = occ;
+                }
+
+                if (n->colors.count() < static_cast<std::size_t>(k)) {
+                    return;
+                }
+                Index length = n->depth;
+                if (n->leaf) {
+                    if (n->depth - n->parent->depth == 1) {
+                        return;
+                    }
+                    --length;
+                }
+                if (length < best) {
+                    return;
+                }
+                if (length > best) {
+                    best = length;
+                    result.clear();
+                }
+                result.push_back({occ.string_id, occ.offset - string_offsets[occ.string_id - 1], length});
+            });
+
+        std::sort(result.begin(), result.end(), [](const SubstringRef& a, const SubstringRef& b) {
+            return a.string_id != b.string_id ? a.string_id < b.string_id : a.offset < b.offset;
+        });
+        return result;
+    }
+
+
+    // =====================================================
+    //          MATCHING STATISTICS
+    // =====================================================
+
+    /**
+     * matching_statistics - Para cada posición j de query, el largo del
+     * prefijo más largo de query[j..] que aparece en algún string
+     *
+     * Recorre query una sola vez al estilo de Ukkonen: el punto activo es
+     * (v, query[j + depth(v), j + out[j])) y, al pasar de j a j + 1, se
+     * sigue el suffix link de v (out[j + 1] >= out[j] - 1) y se vuelve a
+     * canonizar saltando aristas enteras por su largo (skip/count), sin
+     * comparar caracteres ya comparados. O(|query|) en total, sin reservar
+     * memoria y sin modificar el árbol.
+     *
+     * Un END_TOKEN en query nunca coincide.
+     *
+     * @param out: [out] out[j] = estadística de la posición j
+     * @return false si out es más corto que query o hay un string abierto
+     *         (begin_string sin finish_string)
+     */
+    bool SuffixTree::matching_statistics(std::string_view query, std::span<Index> out) const {
+        if (out.size() < query.size() or stream_id != 0) {
+            return false;
+        }
+
+        Index m = static_cast<Index>(query.size());
+        const Node* v = &tree.root;     // nodo explícito más profundo del punto activo
+        Index matched = 0;
+
+        for (Index j = 0; j < m; ++j) {
+            // Extender el punto activo carácter a carácter
+            while (j + matched < m and query[j + matched] != END_TOKEN) {
+                const Transition* t = v->children().find(query[j + v->depth]);
+                if (t == nullptr or text[t->sub.l + matched - v->depth] != query[j + matched]) {
+                    break;
+                }
+                // Una arista de hoja termina en END_TOKEN: nunca se llega a la hoja
+                if (++matched == t->tgt->depth) {
+                    v = t->tgt;
+                }
+            }
+            out[j] = matched;
+            if (matched == 0) {
+                continue;
+            }
+
+            // Siguiente sufijo de query: se pierde el primer carácter
+            --matched;
+            if (v != &tree.root) {
+                v = v->suffix_link;
+            }
+            // Canonizar: bajar por aristas que query[j + 1, j + 1 + matched) cubre enteras
+            while (matched > v->depth) {
+                const Transition* t = v->children().find(query[j + 1 + v->depth]);
+                if (t->tgt->depth > matched) {
+                    break;
+                }
+                v = t->tgt;
+            }
+        }
+        return true;
+    }
+
+
+} // namespace aed::structure
@@ -0,0 +1,281 @@
+#include "../include/SuffixTree.h"
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+namespace aed::structure {
+
+    using Node       = SuffixTree::Node;
+    using Transition = SuffixTree::Transition;
+    using Index      = SuffixTree::Index;
+
+    namespace {
+
+        using Word = std::uint64_t;
+        constexpr int WORD_BITS = 64;
+
+        /**
+         * Columna j de la matriz de distancias entre el patrón y lo
+         * deletreado desde root, guardada como deltas verticales (Myers):
+         * D[i][j] - D[i - 1][j] es +1 si el bit i - 1 de Pv está prendido,
+         * -1 si lo está el de Mv, y 0 si no. D[0][j] = j.
+         */
+        class EditColumn {
+        public:
+            EditColumn(std::string_view pattern)
+                : m(static_cast<int>(pattern.size())),
+                  words((m + WORD_BITS - 1) / WORD_BITS),
+                  last_bit(Word{1} << ((m - 1) % WORD_BITS)),
+                  peq(256 * static_cast<std::size_t>(words), 0) {
+                for (int i = 0; i < m; ++i) {
+                    std::size_t c = static_cast<unsigned char>(pattern[i]);
+                    peq[c * words + i / WORD_BITS] |= Word{1} << (i % WORD_BITS);
+                }
+            }
+
+            int size() const {
+                return 2 * words;
+            }
+
+            // Columna 0: D[i][0] = i
+            void init(Word* col) const {
+                std::fill(col, col + words, ~Word{0});
+                std::fill(col + words, col + 2 * words, Word{0});
+            }
+
+            /**
+             * advance - Pasa de la columna j a la j + 1 leyendo c (Advance_Block
+             * de Myers por palabra, con +1 de entrada en la fila 0)
+             *
+             * @return cambio de D[m] (-1, 0 o +1)
+             */
+            int advance(Word* col, char c) const {
+                const Word* eq_row = peq.data() + static_cast<unsigned char>(c) * static_cast<std::size_t>(words);
+                int hin = 1;
+                for (int w = 0; w < words; ++w) {
+                    Word pv = col[w];
+                    Word mv = col[words + w];
+                    Word eq = eq_row[w];
+                    Word xv = eq | mv;
+                    if (hin < 0) {
+                        eq |= 1;
+                    }
+                    Word xh = (((eq & pv) + pv) ^ pv) | eq;
+                    Word ph = mv | ~(xh | pv);
+                    Word mh = pv & xh;
+
+                    Word high = w + 1 == words ? last_bit : Word{1} << (WORD_BITS - 1);
+                    int hout = (ph & high) ? 1 : (mh & high) ? -1 : 0;
+                    ph <<= 1;
+                    mh <<= 1;
+                    if (hin < 0) {
+                        mh |= 1;
+                    } else if (hin > 0) {
+                        ph |= 1;
+                    }
+                    col[w] = mh | ~(xv | ph);
+                    col[words + w] = ph & xv;
+                    hin = hout;
+                }
+                return hin;
+            }
+
+            /**
+             * within - Si algún D[i][j] de la columna es <= k (si no, ninguna
+             * extensión baja de k: la rama se poda). Como D[i][j] >= |i - j|,
+             * solo hace falta la banda de filas [j - k, j + k]: el valor de
+             * la primera sale de contar bits (popcount) y el resto se suma
+             * fila a fila. O(m / 64 + k).
+             */
+            bool within(const Word* col, Index j, int k) const {
+                long first = std::max<long>(0, static_cast<long>(j) - k);
+                long last = std::min<long>(m, static_cast<long>(j) + k);
+                if (first > last) {
+                    return false;
+                }
+
+                // D[first][j] = j + (deltas de las filas 1..first)
+                long value = j;
+                for (long w = 0; w * WORD_BITS < first; ++w) {
+                    Word below = first - w * WORD_BITS >= WORD_BITS
+                        ? ~Word{0}
+                        : (Word{1} << (first - w * WORD_BITS)) - 1;
+                    value += std::popcount(col[w] & below) - std::popcount(col[words + w] & below);
+                }
+                for (long i = first; ; ++i) {
+                    if (value <= k) {
+                        return true;
+                    }
+                    if (i == last) {
+                        return false;
+                    }
+                    Word bit = Word{1} << (i % WORD_BITS);
+                    value += ((col[i / WORD_BITS] & bit) != 0) - ((col[words + i / WORD_BITS] & bit) != 0);
+                }
+            }
+
+        private:
+            int m;
+            int words;
+            Word last_bit;          // fila m dentro de la última palabra
+            std::vector<Word> peq;  // peq[c * words + w]: posiciones de c en el patrón
+        };
+
+    } // namespace
+
+    // =====================================================
+    //          BUSQUEDA APROXIMADA
+    // =====================================================
+
+    /**
+     * find_approximate - Apariciones de pattern con a lo sumo k errores
+     *
+     * Recorre el árbol desde root deletreando los sufijos y poda cada rama
+     * apenas ninguna extensión puede quedar a k errores o menos, así que
+     * los prefijos comunes se comparan una sola vez.
+     *  - Hamming: substrings de largo |pattern| con k sustituciones o menos.
+     *  - Edit: substrings (no vacíos) a distancia de edición k o menos.
+     *    Cada carácter de las aristas actualiza la columna de la matriz de
+     *    distancias con el método bit-paralelo de Myers, y la poda solo mira
+     *    la banda de k filas alrededor de la diagonal (O(|pattern| / 64 + k)
+     *    por carácter).
+     * Cada posición de inicio se reporta una vez, con su menor cantidad de
+     * errores (y el largo más corto que la logra, en Edit).
+     *
+     * @return ordenadas por string y offset; vacío con pattern vacío, k < 0
+     *         o un string abierto (begin_string sin finish_string)
+     */
+    std::vector<ApproximateMatch> SuffixTree::find_approximate(std::string_view pattern, int k,
+                                                               ErrorModel model) const {
+        std::vector<ApproximateMatch> result;
+        if (pattern.empty() or k < 0 or stream_id != 0) {
+            return result;
+        }
+        if (model == ErrorModel::Hamming) {
+            search_hamming(pattern, k, result);
+        } else {
+            search_edit(pattern, k, result);
+        }
+        std::sort(result.begin(), result.end(), [](const ApproximateMatch& a, const ApproximateMatch& b) {
+            return a.string_id != b.string_id ? a.string_id < b.string_id : a.offset < b.offset;
+        });
+        return result;
+    }
+
+    /**
+     * search_hamming - Branch and bound por cantidad de sustituciones
+     *
+     * Cada marco es un nodo y los errores del camino hasta él; una arista
+     * se abandona al pasar de k errores o al llegar a END_TOKEN antes de
+     * completar el patrón.
+     */
+    void SuffixTree::search_hamming(std::string_view pattern, int k, std::vector<ApproximateMatch>& out) const {
+        struct Frame {
+            const Node* node;
+            int errors;
+        };
+        Index m = static_cast<Index>(pattern.size());
+        std::vector<Frame> stack{{&tree.root, 0}};
+
+        while (!stack.empty()) {
+            Frame f = stack.back();
+            stack.pop_back();
+            for (auto&& child : f.node->children()) {
+                const Transition& t = child.second;
+                Index depth = f.node->depth;
+                Index len = t.tgt->depth - depth;
+                int errors = f.errors;
+                Index i = 0;
+                for (; i < len and depth + i < m and errors <= k; ++i) {
+                    char c = text[t.sub.l + i];
+                    if (c == END_TOKEN) {
+                        errors = k + 1;
+                    } else if (c != pattern[depth + i]) {
+                        ++errors;
+                    }
+                }
+                if (errors > k) {
+                    continue;
+                }
+                if (depth + i == m) {
+                    auto push = [&](const Occurrence& occ) {
+                        out.push_back({occ.string_id, occ.offset, m, errors});
+                    };
+                    report_subtree(t.tgt, push);
+                } else {
+                    // Arista completa sin END_TOKEN: t.tgt es interno
+                    stack.push_back({t.tgt, errors});
+                }
+            }
+        }
+    }
+
+    /**
+     * search_edit - Branch and bound por distancia de edición
+     *
+     * Cada marco guarda la columna de su nodo (en un solo vector, como
+     * pila), D[m] y el mejor D[m] del camino. Una rama muere cuando toda
+     * la columna pasa de k, o en END_TOKEN; ahí se reportan las hojas de
+     * abajo si el mejor del camino quedó en k o menos.
+     */
+    void SuffixTree::search_edit(std::string_view pattern, int k, std::vector<ApproximateMatch>& out) const {
+        struct Frame {
+            const Node* node;
+            int score;          // D[m] en la columna del nodo
+            int best;           // menor D[m] del camino (sin el vacío)
+            Index best_length;
+        };
+        EditColumn column(pattern);
+        std::size_t size = static_cast<std::size_t>(column.size());
+
+        std::vector<Word> columns(size);
+        column.init(columns.data());
+        std::vector<Frame> stack{{&tree.root, static_cast<int>(pattern.size()), INT_MAX, 0}};
+        std::vector<Word> base(size), work(size);
+
+        while (!stack.empty()) {
+            Frame f = stack.back();
+            stack.pop_back();
+            std::copy_n(columns.end() - size, size, base.begin());
+            columns.resize(columns.size() - size);
+
+            for (auto&& child : f.node->children()) {
+                const Transition& t = child.second;
+                Index j = f.node->depth;
+                Index end = t.tgt->depth;
+                Frame next{t.tgt, f.score, f.best, f.best_length};
+                std::copy(base.begin(), base.end(), work.begin());
+
+                bool alive = true;
+                for (const char* c = text.data() + t.sub.l; alive and j < end; ++c) {
+                    if (*c == END_TOKEN) {
+                        alive = false;
+                        break;
+                    }
+                    next.score += column.advance(work.data(), *c);
+                    ++j;
+                    if (next.score < next.best) {
+                        next.best = next.score;
+                        next.best_length = j;
+                    }
+                    alive = column.within(work.data(), j, k);
+                }
+
+                if (alive) {
+                    // Arista completa sin END_TOKEN: t.tgt es interno
+                    columns.insert(columns.end(), work.begin(), work.end());
+                    stack.push_back(next);
+                } else if (next.best <= k) {
+                    auto push = [&](const Occurrence& occ) {
+                        out.push_back({occ.string_id, occ.offset, next.best_length, next.best});
+                    };
+                    report_subtree(t.tgt, push);
+                }
+            }
+        }
+    }
+
+
+} // namespace aed::structure
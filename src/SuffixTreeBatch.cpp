@@ -0,0 +1,224 @@
+#include "../include/SuffixTree.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#if defined(__GNUC__)
+#define AED_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define AED_PREFETCH(addr) ((void)(addr))
+#endif
+
+namespace aed::structure {
+
+    using Node       = SuffixTree::Node;
+    using Transition = SuffixTree::Transition;
+    using Index      = SuffixTree::Index;
+
+    // Consultas que avanzan intercaladas: mientras una espera su nodo de
+    // memoria las demás trabajan sobre nodos ya traídos
+    static constexpr std::size_t QUERY_LANES = 8;
+
+    /**
+     * prefix_order - Índices de patterns ordenados por sus primeros 8 caracteres
+     *
+     * Radix sort LSD sobre la clave de 8 bytes (una pasada por byte, se
+     * salta si todos comparten ese byte). Alcanza para que patrones con
+     * prefijo común queden juntos; el orden exacto no hace falta.
+     */
+    static std::vector<std::size_t> prefix_order(std::span<const std::string_view> patterns, std::size_t n) {
+        struct Keyed {
+            std::uint64_t key;
+            std::size_t index;
+        };
+        std::vector<Keyed> keyed(n), tmp(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            std::uint64_t key = 0;
+            for (std::size_t j = 0; j < 8; ++j) {
+                unsigned char c = j < patterns[i].size() ? static_cast<unsigned char>(patterns[i][j]) : 0;
+                key = (key << 8) | c;
+            }
+            keyed[i] = {key, i};
+        }
+
+        for (int shift = 0; shift < 64; shift += 8) {
+            std::array<std::size_t, 257> bucket{};
+            for (const Keyed& e : keyed) {
+                ++bucket[((e.key >> shift) & 0xFF) + 1];
+            }
+            if (std::find(bucket.begin(), bucket.end(), n) != bucket.end()) {
+                continue;
+            }
+            for (std::size_t b = 0; b < 256; ++b) {
+                bucket[b + 1] += bucket[b];
+            }
+            for (const Keyed& e : keyed) {
+                tmp[bucket[(e.key >> shift) & 0xFF]++] = e;
+            }
+            keyed.swap(tmp);
+        }
+
+        std::vector<std::size_t> order(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            order[i] = keyed[i].index;
+        }
+        return order;
+    }
+
+    // =====================================================
+    //          CONSULTAS EN LOTE
+    // =====================================================
+
+    /**
+     * query_batch - is_substring para muchos patrones a la vez
+     *
+     * Los patrones se ordenan por prefijo (prefix_order) y se reparten en
+     * QUERY_LANES rangos contiguos. Cada carril recuerda el camino del
+     * patrón anterior: el siguiente retoma desde el nodo más profundo
+     * dentro del prefijo común, y si el anterior falló dentro de ese
+     * prefijo la respuesta es false sin tocar el árbol.
+     *
+     * Los carriles avanzan de a una arista por turno. Al elegir una
+     * arista se hace prefetch de su nodo destino y de su etiqueta en
+     * text, que se leen recién en el turno siguiente del carril.
+     *
+     * Mismo resultado que is_substring: el patrón vacío está, uno con
+     * END_TOKEN no. Con un string abierto todos dan false.
+     *
+     * @param found: found[i] indica si patterns[i] es substring; se
+     *               procesan min(patterns.size(), found.size()) patrones
+     * @return cantidad de patrones que son substring
+     */
+    std::size_t SuffixTree::query_batch(std::span<const std::string_view> patterns, std::span<bool> found) const {
+        std::size_t n = std::min(patterns.size(), found.size());
+        if (stream_id != 0) {
+            std::fill_n(found.begin(), n, false);
+            return 0;
+        }
+
+        std::vector<std::size_t> order = prefix_order(patterns, n);
+
+        struct Lane {
+            std::size_t next, end;          // rango pendiente de order
+            std::size_t current;            // índice del patrón en curso
+            std::string_view prev;          // último patrón resuelto
+            Index prev_matched;             // caracteres de prev presentes en el árbol
+            std::vector<const Node*> path;  // nodos de root al punto actual
+            const Transition* edge;         // arista elegida, pendiente de comparar
+        };
+
+        std::array<Lane, QUERY_LANES> lanes;
+        for (std::size_t k = 0; k < QUERY_LANES; ++k) {
+            lanes[k].next = n * k / QUERY_LANES;
+            lanes[k].end = n * (k + 1) / QUERY_LANES;
+            lanes[k].prev = {};
+            lanes[k].prev_matched = 0;
+            lanes[k].path.assign(1, &tree.root);
+            lanes[k].edge = nullptr;
+        }
+
+        std::size_t hits = 0;
+
+        auto resolve = [&](Lane& lane, bool result, Index matched) {
+            found[lane.current] = result;
+            hits += result;
+            lane.prev = patterns[lane.current];
+            lane.prev_matched = matched;
+            lane.edge = nullptr;
+        };
+
+        // Elige la arista de p[k] desde el final del camino, o resuelve false
+        auto choose_edge = [&](Lane& lane, std::string_view p) {
+            const Node* node = lane.path.back();
+            const Transition* t = node->children().find(p[node->depth]);
+            if (t == nullptr) {
+                resolve(lane, false, node->depth);
+                return;
+            }
+            lane.edge = t;
+            AED_PREFETCH(t->tgt);
+            AED_PREFETCH(text.data() + t->sub.l);
+        };
+
+        // Toma patrones del rango hasta que uno necesite bajar por el árbol
+        auto start_next = [&](Lane& lane) {
+            while (lane.edge == nullptr and lane.next < lane.end) {
+                lane.current = order[lane.next++];
+                std::string_view p = patterns[lane.current];
+                Index m = static_cast<Index>(p.size());
+
+                if (contains_end_token(p)) {
+                    found[lane.current] = false;
+                    continue;
+                }
+
+                Index lcp = 0;
+                Index max_lcp = static_cast<Index>(std::min(p.size(), lane.prev.size()));
+                while (lcp < max_lcp and p[lcp] == lane.prev[lcp]) {
+                    ++lcp;
+                }
+
+                if (lcp > lane.prev_matched) {
+                    // prev falló en un carácter que p también tiene
+                    resolve(lane, false, lane.prev_matched);
+                    continue;
+                }
+                if (lcp == m) {
+                    resolve(lane, true, m);
+                    continue;
+                }
+
+                while (lane.path.back()->depth > lcp) {
+                    lane.path.pop_back();
+                }
+                choose_edge(lane, p);
+            }
+        };
+
+        // Compara la arista pendiente y elige la siguiente
+        auto step = [&](Lane& lane) {
+            std::string_view p = patterns[lane.current];
+            Index m = static_cast<Index>(p.size());
+            const Node* node = lane.path.back();
+            const Transition* t = lane.edge;
+            const char* label = text.data() + t->sub.l;
+            Index k = node->depth;
+            Index len = std::min(t->tgt->depth - k, m - k);
+
+            for (Index i = 1; i < len; ++i) {
+                if (p[k + i] != label[i]) {
+                    resolve(lane, false, k + i);
+                    return;
+                }
+            }
+            if (t->tgt->depth >= m) {
+                resolve(lane, true, m);
+                return;
+            }
+            lane.path.push_back(t->tgt);
+            choose_edge(lane, p);
+        };
+
+        for (Lane& lane : lanes) {
+            start_next(lane);
+        }
+
+        bool pending = true;
+        while (pending) {
+            pending = false;
+            for (Lane& lane : lanes) {
+                if (lane.edge == nullptr) {
+                    continue;
+                }
+                step(lane);
+                start_next(lane);
+                pending |= lane.edge != nullptr;
+            }
+        }
+
+        return hits;
+    }
+
+
+} // namespace aed::structure
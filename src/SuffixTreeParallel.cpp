@@ -0,0 +1,394 @@
+#include "../include/SuffixTree.h"
+#include "../include/TreeTraversal.h"
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace aed::structure {
+
+    using Node            = SuffixTree::Node;
+    using MappedSubstring = SuffixTree::MappedSubstring;
+    using Transition      = SuffixTree::Transition;
+    using Base            = SuffixTree::Base;
+    using Index           = SuffixTree::Index;
+    using ColorSet        = SuffixTree::ColorSet;
+
+    // =====================================================
+    //          CONSTRUCCION EN PARALELO
+    // =====================================================
+
+    /**
+     * add_strings_parallel - Agrega varios strings construyendo en paralelo
+     *
+     * 1. Valida y guarda todos los strings en text (mismos IDs y mismos
+     *    AddResult que add_strings).
+     * 2. Reparte los strings aceptados en rangos contiguos de tamaño
+     *    parecido (en caracteres) y cada hilo construye con Ukkonen un GST
+     *    parcial de su rango, que después se traslada a posiciones e IDs
+     *    globales (shift_tree).
+     * 3. Fusiona los árboles parciales de a pares, también en paralelo, y
+     *    el resultado se fusiona en este árbol (merge_tree).
+     * 4. Encadena las hojas que la fusión descartó como sufijos compartidos
+     *    de la hoja que las absorbió (absorb_leaf), en el orden de los
+     *    strings.
+     * 5. Recalcula los suffix links y los colores (una pasada).
+     *
+     * El árbol resultante es el mismo que con add_string secuencial: mismos
+     * nodos, mismas hojas (cada hoja es del primer string que tiene ese
+     * sufijo) y mismos colores. Los nodos de los parciales que la fusión
+     * descarta vuelven con free_node a la lista libre de la arena: size()
+     * cuenta solo los nodos del árbol y las inserciones siguientes reusan
+     * sus ranuras.
+     *
+     * @param threads: cantidad de hilos (0 = hardware_concurrency)
+     * @return un AddResult por string, en el mismo orden
+     */
+    std::vector<SuffixTree::AddResult> SuffixTree::add_strings_parallel(std::span<const std::string_view> strs, unsigned threads) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        std::vector<AddResult> results;
+        results.reserve(strs.size());
+
+        std::size_t total = text.size();
+        for (std::string_view s : strs) {
+            total += s.size() + 1;
+        }
+        text.reserve(std::min(total, static_cast<std::size_t>(std::numeric_limits<Index>::max())));
+        string_offsets.reserve(string_offsets.size() + strs.size());
+
+        // Los strings aceptados reciben IDs consecutivos desde first_id
+        int first_id = last_index + 1;
+        std::vector<std::string_view> accepted;
+        for (std::string_view s : strs) {
+            AddStatus status = check_string(s);
+            if (status != AddStatus::Ok) {
+                results.push_back({-1, status});
+                continue;
+            }
+            results.push_back({store_string(s), AddStatus::Ok});
+            accepted.push_back(s);
+        }
+
+        std::size_t parts_count = std::min<std::size_t>(threads, accepted.size());
+        if (parts_count <= 1) {
+            for (int id = first_id; id <= last_index; ++id) {
+                deploy_suffixes(id);
+            }
+            compute_colors();
+            return results;
+        }
+
+        // Rangos contiguos [cuts[k], cuts[k + 1]) con igual cantidad de caracteres
+        Index chars = string_offsets.back() - string_offsets[first_id - 1];
+        std::vector<std::size_t> cuts{0};
+        for (std::size_t i = 0; i < accepted.size() and cuts.size() < parts_count; ++i) {
+            Index done = string_offsets[first_id + i] - string_offsets[first_id - 1];
+            if (done >= static_cast<Index>(chars / parts_count * cuts.size())) {
+                cuts.push_back(i + 1);
+            }
+        }
+        if (cuts.back() != accepted.size()) {
+            cuts.push_back(accepted.size());
+        }
+        parts_count = cuts.size() - 1;
+
+        std::vector<std::unique_ptr<SuffixTree>> parts(parts_count);
+        std::vector<std::thread> workers;
+
+        for (std::size_t k = 0; k < parts_count; ++k) {
+            workers.emplace_back([&, k] {
+                auto part = std::make_unique<SuffixTree>();
+                part->colors_computed = false;
+                for (std::size_t i = cuts[k]; i < cuts[k + 1]; ++i) {
+                    part->deploy_suffixes(part->store_string(accepted[i]));
+                }
+                parts[k] = std::move(part);
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+
+        // Las listas de sufijos compartidos de cada parcial van una tras otra
+        std::vector<Index> shared_shift(parts_count);
+        Index shared_total = static_cast<Index>(shared_suffixes.size());
+        for (std::size_t k = 0; k < parts_count; ++k) {
+            shared_shift[k] = shared_total;
+            shared_total += static_cast<Index>(parts[k]->shared_suffixes.size());
+        }
+
+        workers.clear();
+        for (std::size_t k = 0; k < parts_count; ++k) {
+            workers.emplace_back([&, k] {
+                int id_shift = first_id - 1 + static_cast<int>(cuts[k]);
+                shift_tree(*parts[k], string_offsets[id_shift], id_shift, shared_shift[k]);
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+
+        shared_suffixes.reserve(shared_total);
+        for (auto& part : parts) {
+            shared_suffixes.insert(shared_suffixes.end(),
+                                   part->shared_suffixes.begin(), part->shared_suffixes.end());
+        }
+        for (Index e = shared_shift[0]; e < shared_total; ++e) {
+            shared_at[shared_suffixes[e].start] = e;
+        }
+
+        // Fusión por pares: el de la izquierda siempre tiene los strings
+        // anteriores. Las hojas absorbidas se guardan por nivel para
+        // encadenarlas después en el orden de los strings.
+        std::vector<std::vector<std::pair<Node*, Node*>>> absorbed;
+        for (std::size_t step = 1; step < parts_count; step *= 2) {
+            std::size_t first = absorbed.size();
+            for (std::size_t k = 0; k + step < parts_count; k += 2 * step) {
+                absorbed.emplace_back();
+            }
+            workers.clear();
+            for (std::size_t k = 0, slot = first; k + step < parts_count; k += 2 * step, ++slot) {
+                workers.emplace_back([&, k, step, slot] {
+                    merge_tree(parts[k]->tree, parts[k + step]->tree, absorbed[slot]);
+                });
+            }
+            for (auto& w : workers) {
+                w.join();
+            }
+        }
+        absorbed.emplace_back();
+        merge_tree(tree, parts[0]->tree, absorbed.back());
+
+        for (auto& level : absorbed) {
+            // Una hoja descartada solo fue `into` en niveles anteriores
+            for (auto [into, from] : level) {
+                absorb_leaf(into, from);
+                tree.arena.free_node(from);
+            }
+        }
+
+        rebuild_suffix_links();
+        colors_computed = false;
+        compute_colors();
+
+        return results;
+    }
+
+
+    /**
+     * shift_tree - Traslada un árbol parcial a posiciones e IDs globales
+     *
+     * El árbol se construyó sobre su propio text: sus posiciones se corren
+     * offset_shift lugares y sus IDs id_shift, de modo que sus aristas
+     * quedan referidas al text del árbol completo. Sus SharedSuffix pasarán
+     * a estar desde shared_shift en la lista del árbol completo.
+     */
+    void SuffixTree::shift_tree(SuffixTree& part, Index offset_shift, int id_shift, Index shared_shift) {
+        for (SharedSuffix& occ : part.shared_suffixes) {
+            occ.string_id += id_shift;
+            occ.start += offset_shift;
+            if (occ.next >= 0) {
+                occ.next += shared_shift;
+            }
+            if (occ.prev >= 0) {
+                occ.prev += shared_shift;
+            }
+        }
+
+        DepthFirst<Node>().run(&part.tree.root, [&](Node* n, Transition* trans) {
+            if (trans != nullptr) {
+                trans->sub.l += offset_shift;
+                if (trans->sub.r != std::numeric_limits<Index>::max()) {
+                    trans->sub.r += offset_shift;
+                }
+                trans->sub.ref_str += id_shift;
+            }
+            if (n->leaf) {
+                n->suffix_start += offset_shift;
+                n->string_id += id_shift;
+                if (n->shared >= 0) {
+                    n->shared += shared_shift;
+                }
+                ColorSet shifted;
+                for (std::size_t c : n->colors) {
+                    shifted.set(c + id_shift);
+                }
+                n->colors = std::move(shifted);
+            }
+            return true;
+        });
+    }
+
+
+    /**
+     * merge_tree - Fusiona el árbol from dentro de into
+     *
+     * Ambos deben estar referidos al text de este árbol, y from debe tener
+     * solo strings posteriores a los de into. Se recorren las aristas de
+     * from comparando su etiqueta con la arista de into que empieza con el
+     * mismo carácter:
+     *  - Si no hay arista, se cuelga el subárbol de from tal cual.
+     *  - Si las etiquetas coinciden completas, se fusionan los nodos: los
+     *    hijos del de from pasan al de into y el de from se libera. Dos
+     *    hojas iguales son el mismo sufijo: se juntan sus colores y el par
+     *    se agrega a absorbed para absorb_leaf, que la libera después.
+     *  - Si divergen, se divide la arista de into en el punto de divergencia.
+     *
+     * Usa una pila explícita y al final toma los bloques de la arena de
+     * from. Los suffix links quedan inválidos (ver rebuild_suffix_links).
+     */
+    void SuffixTree::merge_tree(Base& into, Base& from, std::vector<std::pair<Node*, Node*>>& absorbed) {
+        // Arista de from pendiente de colgar en `at`; edge.sub.l ya avanzado
+        struct Pending {
+            Node* at;
+            Transition edge;
+            Index len;
+        };
+        std::vector<Pending> stack;
+
+        auto push_children = [&](Node* at, Node* node) {
+            for (auto&& pair : node->children()) {
+                stack.push_back({at, pair.second, pair.second.tgt->depth - node->depth});
+            }
+        };
+
+        push_children(&into.root, &from.root);
+
+        while (!stack.empty()) {
+            Pending p = stack.back();
+            stack.pop_back();
+
+            Index bl = p.edge.sub.l;
+            Transition* ta = p.at->children().find(text[bl]);
+
+            if (ta == nullptr) {
+                p.at->children().set(text[bl], p.edge);
+                p.edge.tgt->parent = p.at;
+                continue;
+            }
+
+            Node* a_child = ta->tgt;
+            Index a_len = a_child->depth - p.at->depth;
+            Index al = ta->sub.l;
+            Index m = std::min(a_len, p.len);
+            Index k = 1;
+            while (k < m and text[al + k] == text[bl + k]) {
+                ++k;
+            }
+
+            if (k == a_len and k == p.len) {
+                if (a_child->leaf) {
+                    a_child->colors |= p.edge.tgt->colors;
+                    absorbed.emplace_back(a_child, p.edge.tgt);
+                } else {
+                    push_children(a_child, p.edge.tgt);
+                    from.arena.free_node(p.edge.tgt);
+                }
+                continue;
+            }
+
+            if (k < a_len) {
+                // Dividir la arista de into en k
+                Node* mid = into.arena.make_node();
+                mid->parent = p.at;
+                mid->depth = p.at->depth + k;
+
+                Transition lower = *ta;
+                lower.sub.l += k;
+                mid->children().set(text[lower.sub.l], lower);
+                a_child->parent = mid;
+
+                ta->sub.r = ta->sub.l + k - 1;
+                ta->tgt = mid;
+                a_child = mid;
+            }
+
+            if (k == p.len) {
+                // Mismo camino que a_child (el nuevo nodo o el de into)
+                push_children(a_child, p.edge.tgt);
+                from.arena.free_node(p.edge.tgt);
+            } else {
+                p.edge.sub.l += k;
+                stack.push_back({a_child, p.edge, p.len - k});
+            }
+        }
+
+        from.root.g.clear();
+        into.arena.adopt(from.arena);
+    }
+
+
+    /**
+     * absorb_leaf - Encadena la hoja descartada from como sufijo compartido
+     *
+     * from y su lista pasan delante de la lista de into: sus strings son
+     * posteriores al de into pero anteriores a los que into ya tenía
+     * encadenados por fusiones de niveles siguientes.
+     */
+    void SuffixTree::absorb_leaf(Node* into, Node* from) {
+        Index head = static_cast<Index>(shared_suffixes.size());
+        shared_suffixes.push_back({from->string_id, from->suffix_start, from->shared, -1});
+        shared_at[from->suffix_start] = head;
+        if (from->shared >= 0) {
+            shared_suffixes[from->shared].prev = head;
+        }
+
+        Index tail = head;
+        while (shared_suffixes[tail].next >= 0) {
+            tail = shared_suffixes[tail].next;
+        }
+        shared_suffixes[tail].next = into->shared;
+        if (into->shared >= 0) {
+            shared_suffixes[into->shared].prev = tail;
+        }
+        into->shared = head;
+    }
+
+
+    /**
+     * rebuild_suffix_links - Recalcula los suffix links de los nodos internos
+     *
+     * En pre-order, el enlace de v (etiqueta xα) se obtiene bajando desde el
+     * enlace de su padre por la etiqueta de la arista, saltando aristas
+     * completas por su largo (skip/count) sin comparar caracteres.
+     */
+    void SuffixTree::rebuild_suffix_links() {
+        tree.root.suffix_link = &tree.sink;
+
+        DepthFirst<Node>().run(&tree.root, [&](Node* v, Transition* trans) {
+            if (v->leaf) {
+                return false;
+            }
+            if (trans == nullptr) {
+                return true;
+            }
+
+            Node* p = v->parent;
+            Index l = trans->sub.l;
+            Index len = v->depth - p->depth;
+            Node* w = p->suffix_link;
+            if (p == &tree.root) {
+                w = &tree.root;
+                ++l;
+                --len;
+            }
+
+            while (len > 0) {
+                Node* child = w->children().find(text[l])->tgt;
+                Index edge_len = child->depth - w->depth;
+                l += edge_len;
+                len -= edge_len;
+                w = child;
+            }
+
+            v->suffix_link = w;
+            return true;
+        });
+    }
+
+
+} // namespace aed::structure
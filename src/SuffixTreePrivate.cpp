@@ -1,4 +1,5 @@
 #include "../include/SuffixTree.h"
+#include "../include/TreeTraversal.h"
 #include <vector>
 #include <limits>
 #include <algorithm>
@@ -9,8 +10,6 @@ namespace aed::structure {
     using Node            = SuffixTree::Node;
     using MappedSubstring = SuffixTree::MappedSubstring;
     using Transition      = SuffixTree::Transition;
-    using SinkNode        = SuffixTree::SinkNode;
-    using Leaf            = SuffixTree::Leaf;
     using ReferencePoint  = SuffixTree::ReferencePoint;
     using Base            = SuffixTree::Base;
     using Index           = SuffixTree::Index;
@@ -24,20 +23,13 @@ namespace aed::structure {
      * Convierte un substring a string legible (para debugging)
      */
     std::string SuffixTree::substring_to_string(const MappedSubstring& substr) const {
-        auto it = haystack.find(substr.ref_str);
-        if(it == haystack.end() or substr.empty()) {
+        if(substr.ref_str <= 0 or substr.ref_str > last_index or substr.empty()) {
             return "";
         }
 
-        const std::string& str = it->second;
-        std::string result;
-
-        Index end = std::min(substr.r, static_cast<Index>(str.size() - 1));
-        for (Index i = substr.l; i <= end; ++i) {
-            result.push_back(str[i]);
-        }
-
-        return result;
+        // Las hojas llegan hasta "infinito": se corta en el END_TOKEN del string
+        Index end = std::min(substr.r, string_offsets[substr.ref_str] - 1);
+        return text.substr(substr.l, end - substr.l + 1);
     }
 
 
@@ -51,48 +43,52 @@ namespace aed::structure {
      * @param n: nodo actual
      * @param kp: substring que representa la posición
      * @param t: carácter a verificar
-     * @param w: string de referencia
      * @param r: [out] nodo resultante
      * @return true si es endpoint, false si se tuvo que dividir
      */
-    bool SuffixTree::test_and_split(Node* n, MappedSubstring kp, char t, const std::string& w, Node** r) {
+    bool SuffixTree::test_and_split(Node* n, MappedSubstring kp, char t, Node** r) {
         Index delta = kp.r - kp.l;
 
         if(delta < 0) {
             *r = n;
-            Transition t_trans = n->find_alpha_transition(t);
 
-            if (t_trans.is_valid() and t_trans.tgt != nullptr && kp.ref_str > 0) {
-                t_trans.tgt->mark_string(kp.ref_str);
+            // El sumidero tiene transición con cualquier carácter
+            if (n == &tree.sink) {
+                return true;
             }
 
+            Transition t_trans = n->find_alpha_transition(t);
             return t_trans.is_valid();
         }
 
-        char tk = w[kp.l];
+        char tk = text[kp.l];
         Transition tk_trans = n->find_alpha_transition(tk);
         MappedSubstring kp_prime = tk_trans.sub;
 
-        auto str_it = haystack.find(kp_prime.ref_str);
-        const std::string& str_prime = str_it->second;
-
-        if (str_prime[kp_prime.l + delta + 1] == t) {
+        if (text[kp_prime.l + delta + 1] == t) {
             *r = n;
             return true; // es endpoint
         }
 
         // Crear nuevo nodo intermedio
-        *r = new Node();
+        *r = tree.arena.make_node();
+        (*r)->parent = n;
+        (*r)->depth = n->depth + delta + 1;
 
         Transition new_trans = tk_trans;
         new_trans.sub.l += delta + 1;
-        (*r)->g.insert({str_prime[new_trans.sub.l], new_trans});
+        (*r)->children().set(text[new_trans.sub.l], new_trans);
+        new_trans.tgt->parent = *r;
+
+        // El subárbol del nodo nuevo es el del hijo (más la hoja que cuelga
+        // después, que se colorea al crearse)
+        if (colors_computed) {
+            (*r)->colors = new_trans.tgt->colors;
+        }
 
         tk_trans.sub.r = tk_trans.sub.l + delta;
         tk_trans.tgt = *r;
-        n->g[tk] = tk_trans;
-
-        colors_computed = false;
+        n->children().set(tk, tk_trans);
 
         return false;
     }
@@ -113,25 +109,39 @@ namespace aed::structure {
         Node* r = nullptr;
         bool is_endpoint = false;
 
-        const std::string& w = haystack[ki.ref_str];
+        const std::string& w = text;
         MappedSubstring ki1 = ki;
         ki1.r = ki.r - 1; // Excluir el último carácter
 
         ReferencePoint sk(n, ki.ref_str, ki.l);
 
         // Probar y dividir en el punto actual
-        is_endpoint = test_and_split(n, ki1, w[ki.r], w, &r);
+        is_endpoint = test_and_split(n, ki1, w[ki.r], &r);
 
         while (!is_endpoint) {
-            // Crear nueva hoja
-            Leaf* r_prime = new Leaf();
+            // Crear nueva hoja: el sufijo es label(r) + w[ki.r..]
+            Node* r_prime = tree.arena.make_leaf();
+            r_prime->parent = r;
+            r_prime->string_id = ki.ref_str;
+            r_prime->suffix_start = ki.r - r->depth;
+            if (ki.ref_str == stream_id) {
+                // El string sigue abierto: el largo se fija en finish_string
+                r_prime->suffix_link = stream_leaves;
+                stream_leaves = r_prime;
+            } else {
+                r_prime->depth = string_offsets[ki.ref_str] - r_prime->suffix_start;
+            }
+            r_prime->mark_string(ki.ref_str);
+            if (colors_computed) {
+                propagate_color(r, ki.ref_str);
+            }
 
             // Agregar transición al nodo actual
             // El substring va desde ki.r hasta el infinito (representado con max)
-            r->g.insert({w[ki.r],
-                        Transition(MappedSubstring(ki.ref_str, ki.r,
-                                  std::numeric_limits<Index>::max()),
-                                  r_prime)});
+            r->children().set(w[ki.r],
+                     Transition(MappedSubstring(ki.ref_str, ki.r,
+                               std::numeric_limits<Index>::max()),
+                               r_prime));
 
             // Actualizar suffix links
             if (oldr != &tree.root) {
@@ -144,7 +154,7 @@ namespace aed::structure {
             ki1.l = ki.l = sk.pos;
 
             // Probar y dividir en el nuevo punto
-            is_endpoint = test_and_split(sk.node, ki1, w[ki.r], w, &r);
+            is_endpoint = test_and_split(sk.node, ki1, w[ki.r], &r);
         }
 
         // Actualizar último suffix link
@@ -175,7 +185,16 @@ namespace aed::structure {
             return ReferencePoint(n, kp.ref_str, kp.l);
         }
 
-        const std::string& str = haystack[kp.ref_str];
+        const std::string& str = text;
+
+        // Desde el sumidero se consume un carácter y se llega a la raíz
+        if (n == &tree.sink) {
+            ++kp.l;
+            n = &tree.root;
+            if (kp.r < kp.l) {
+                return ReferencePoint(n, kp.ref_str, kp.l);
+            }
+        }
 
         Transition tk_trans = n->find_alpha_transition(str[kp.l]);
         Index delta;
@@ -204,7 +223,7 @@ namespace aed::structure {
      * @param r: [in/out] punto de referencia (inicio/fin del recorrido)
      * @return índice donde diverge, o max si coincide completamente
      */
-    Index SuffixTree::get_starting_node(const std::string &s, ReferencePoint* r) {
+    Index SuffixTree::get_starting_node(std::string_view s, ReferencePoint* r) {
         Index k = r->pos;
         Index s_len = s.size();
         bool s_runout = false;
@@ -222,7 +241,7 @@ namespace aed::structure {
 
             if (t.tgt != nullptr) {
                 // Hay transición, verificar coincidencia carácter por carácter
-                const std::string& ref_str = haystack[t.sub.ref_str];
+                const char* edge = text.data() + t.sub.l;
                 Index i;
 
                 for (i = 1; i <= t.sub.r - t.sub.l; ++i) {
@@ -231,7 +250,7 @@ namespace aed::structure {
                         break;
                     }
 
-                    if (s[k + i] != ref_str[t.sub.l + i]) {
+                    if (s[k + i] != edge[i]) {
                         // Divergencia encontrada
                         r->pos = k;
                         return k + i;
@@ -260,184 +279,342 @@ namespace aed::structure {
      * deploy_suffixes - Despliega sufijos usando Ukkonen
      *
      * Implementa el algoritmo de Ukkonen para insertar todos los sufijos
-     * de s en el árbol de manera incremental.
+     * del string sindex (ya guardado en text) en el árbol de manera
+     * incremental. Si el string completo ya está en el árbol (duplicado o
+     * sufijo de otro string) no se crea ninguna hoja: todos sus sufijos
+     * quedan compartidos.
      *
-     * @param s: string a insertar
      * @param sindex: ID del string
-     * @return ID del string si tuvo éxito, -1 si falló
+     * @return ID del string
      */
-    int SuffixTree::deploy_suffixes(const std::string& s, int sindex) {
+    int SuffixTree::deploy_suffixes(int sindex) {
+        Index base = string_offsets[sindex - 1];
+        Index end = string_offsets[sindex];
+        std::string_view s(text.data() + base, end - base);
+
         ReferencePoint active_point(&tree.root, sindex, 0);
 
         Index i = get_starting_node(s, &active_point);
 
         if (i == std::numeric_limits<Index>::max()) {
-            return -1;
+            // s ya existe completo: se recorre desde la raíz sin crear hojas
+            active_point = ReferencePoint(&tree.root, sindex, 0);
+            i = 0;
         }
 
-        for (; i < s.size(); ++i) {
-            MappedSubstring ki(sindex, active_point.pos, i);
-            active_point = update(active_point.node, ki);
-            ki.l = active_point.pos;
-            active_point = canonize(active_point.node, ki);
+        // get_starting_node trabaja con posiciones locales de s
+        active_point.pos += base;
+
+        for (i += base; i < end; ++i) {
+            active_point = extend(active_point, sindex, i);
         }
 
+        mark_shared_suffixes(active_point, sindex);
+
         return sindex;
     }
 
+    /**
+     * extend - Una fase de Ukkonen: agrega text[i] al string sindex
+     *
+     * @param active_point: punto activo canónico antes de text[i]
+     * @return punto activo canónico después de text[i]
+     */
+    ReferencePoint SuffixTree::extend(ReferencePoint active_point, int sindex, Index i) {
+        MappedSubstring ki(sindex, active_point.pos, i);
+        active_point = update(active_point.node, ki);
+        ki.l = active_point.pos;
+        return canonize(active_point.node, ki);
+    }
+
 
     /**
-     * compute_colors_dfs - Calcula colores de nodos usando DFS
+     * mark_shared_suffixes - Colorea los sufijos que no crearon hoja
      *
-     * Realiza un recorrido post-order del árbol para propagar los colores
-     * desde las hojas hacia la raíz. Cada nodo acumula los colores de todos
-     * sus descendientes.
+     * Al terminar Ukkonen, los sufijos desde el punto activo hasta el final
+     * (terminados en el END_TOKEN compartido) ya existían como hojas de otros
+     * strings. Se recorren con suffix links: cada hoja recibe el color de
+     * sindex y la ocurrencia se encadena en su lista de SharedSuffix.
      *
-     * @param node: nodo actual
-     * @return ColorSet con los colores acumulados del subárbol
+     * @param active_point: punto activo canónico tras el último carácter
+     * @param sindex: ID del string recién desplegado
      */
-    ColorSet SuffixTree::compute_colors_dfs(Node* node) {
-        if (!node) {
-            return ColorSet();
+    void SuffixTree::mark_shared_suffixes(ReferencePoint active_point, int sindex) {
+        Index end = string_offsets[sindex];
+
+        // Lo que falta de cada sufijo termina en END_TOKEN: siempre es una arista de hoja
+        while (active_point.pos < end) {
+            Node* leaf = active_point.node->children().find(text[active_point.pos])->tgt;
+            leaf->mark_string(sindex);
+            push_shared(leaf, sindex, end - leaf->depth);
+            if (colors_computed) {
+                propagate_color(leaf->parent, sindex);
+            }
+            active_point = canonize(active_point.node->suffix_link,
+                                    MappedSubstring(sindex, active_point.pos, end - 1));
         }
+    }
+
 
-        // Si es una hoja, determinar a qué string pertenece
-        if (node->g.empty()) {
-            // Las hojas se crean durante deploy_suffixes
-            // Necesitamos rastrear qué string creó cada hoja
-            return node->colors;
+    /**
+     * push_shared - Encadena una ocurrencia de string_id al frente de la
+     * lista de leaf
+     *
+     * Reusa las entradas que liberó remove_string antes de agrandar
+     * shared_suffixes.
+     *
+     * @return índice de la entrada en shared_suffixes
+     */
+    Index SuffixTree::push_shared(Node* leaf, int string_id, Index start) {
+        SharedSuffix occ{string_id, start, leaf->shared, -1};
+        Index e;
+        if (free_shared >= 0) {
+            e = free_shared;
+            free_shared = shared_suffixes[e].next;
+            shared_suffixes[e] = occ;
+        } else {
+            e = static_cast<Index>(shared_suffixes.size());
+            shared_suffixes.push_back(occ);
+        }
+        if (leaf->shared >= 0) {
+            shared_suffixes[leaf->shared].prev = e;
         }
+        leaf->shared = e;
+        shared_at[start] = e;
+        return e;
+    }
 
-        // Nodo interno: acumular colores de todos los hijos
-        ColorSet accumulated;
-        for (auto& pair : node->g) {
-            Transition& trans = pair.second;
+    /**
+     * unlink_shared - Saca la entrada de la lista de leaf y la libera
+     */
+    void SuffixTree::unlink_shared(Node* leaf, Index entry) {
+        SharedSuffix& occ = shared_suffixes[entry];
+        if (occ.prev >= 0) {
+            shared_suffixes[occ.prev].next = occ.next;
+        } else {
+            leaf->shared = occ.next;
+        }
+        if (occ.next >= 0) {
+            shared_suffixes[occ.next].prev = occ.prev;
+        }
+        shared_at.erase(occ.start);
+        occ = {0, 0, free_shared, -1};
+        free_shared = entry;
+    }
 
-            // Marcar el color del string al que pertenece esta arista
-            if (trans.sub.ref_str > 0 && trans.sub.ref_str <= MAX_STRINGS) {
-                accumulated.set(trans.sub.ref_str - 1);
-            }
 
-            // Recursión: obtener colores del subárbol hijo
-            ColorSet child_colors = compute_colors_dfs(trans.tgt);
-            accumulated |= child_colors;
+    /**
+     * find_locus - Nodo donde termina (o bajo cuya arista termina) pattern
+     *
+     * Solo lectura. El largo de cada arista sale de la diferencia de
+     * profundidades, así que las hojas no necesitan caso especial.
+     *
+     * @param next: [out, opcional] posición en text del carácter que sigue
+     *              a pattern dentro de la arista, o -1 si pattern termina
+     *              justo en el nodo devuelto
+     * @return el nodo, o nullptr si pattern no está en el árbol
+     */
+    const Node* SuffixTree::find_locus(std::string_view pattern, Index* next) const {
+        const Node* node = &tree.root;
+        Index k = 0;
+        Index m = static_cast<Index>(pattern.size());
+        if (next != nullptr) {
+            *next = -1;
         }
 
-        // Actualizar colores de este nodo
-        node->colors = accumulated;
-        return accumulated;
+        while (k < m) {
+            const Transition* t = node->children().find(pattern[k]);
+            if (t == nullptr) {
+                return nullptr;
+            }
+            Index len = t->tgt->depth - node->depth;
+            const char* edge = text.data() + t->sub.l;
+            for (Index i = 1; i < len and k + i < m; ++i) {
+                if (pattern[k + i] != edge[i]) {
+                    return nullptr;
+                }
+            }
+            if (next != nullptr and k + len > m) {
+                *next = t->sub.l + (m - k);
+            }
+            k += len;
+            node = t->tgt;
+        }
+        return node;
     }
 
+
     /**
-     * mark_leaves_for_string - Marca las hojas del string dado
+     * store_string - Agrega str + END_TOKEN al final de text
+     *
+     * Los conteos de apariciones dejan de ser válidos (ver compute_counts).
      *
-     * Recorre el árbol siguiendo los sufijos del string y marca todas
-     * las hojas correspondientes con el ID del string.
+     * @return ID asignado al string
      */
-    void SuffixTree::mark_leaves_for_string(int string_id) {
-        const std::string& str = haystack[string_id];
-
-        // Para cada sufijo del string
-        for (Index start = 0; start < str.size(); ++start) {
-            Node* current = &tree.root;
-            Index pos = start;
-
-            // Seguir el camino del sufijo
-            while (pos < str.size()) {
-                Transition trans = current->find_alpha_transition(str[pos]);
+    int SuffixTree::store_string(std::string_view str) {
+        counts_computed = false;
+        text.append(str);
+        text.push_back(END_TOKEN);
+        string_offsets.push_back(static_cast<Index>(text.size()));
+        return ++last_index;
+    }
 
-                if (!trans.is_valid()) {
-                    break;
+    /**
+     * compute_colors_dfs - Calcula colores de nodos usando DFS
+     *
+     * Realiza un recorrido post-order del árbol (pila explícita, ver
+     * TreeTraversal.h) para propagar los colores desde las hojas hacia la
+     * raíz: cada nodo interno es la unión de sus hijos. Las hojas ya tienen
+     * sus colores desde que se crearon, por lo que el recorrido es O(#nodos).
+     *
+     * @param node: raíz del subárbol
+     * @return ColorSet con los colores acumulados del subárbol
+     */
+    const ColorSet& SuffixTree::compute_colors_dfs(Node* node) {
+        DepthFirst<Node> dfs;
+        dfs.run(node,
+            [](Node* n, Transition*) {
+                if (!n->leaf) {
+                    n->colors.reset();
                 }
+                return true;
+            },
+            [node](Node* n, Transition*) {
+                if (n != node) {
+                    n->parent->colors |= n->colors;
+                }
+            });
+        return node->colors;
+    }
 
-                // Calcular cuántos caracteres coinciden en esta arista
-                const std::string& edge_str = haystack[trans.sub.ref_str];
-                Index edge_len = trans.sub.r - trans.sub.l + 1;
-                Index match_len = 0;
-
-                for (Index i = 0; i < edge_len && pos + i < str.size(); ++i) {
-                    if (str[pos + i] != edge_str[trans.sub.l + i]) {
-                        break;
+    /**
+     * compute_counts_dfs - Calcula count de cada nodo usando DFS
+     *
+     * Post-order con pila explícita: una hoja aparece una vez por su propio
+     * sufijo y una más por cada SharedSuffix encadenado; un nodo interno
+     * suma las apariciones de sus hijos. O(#nodos + #sufijos compartidos).
+     *
+     * @param node: raíz del subárbol
+     * @return apariciones de la etiqueta de node
+     */
+    Index SuffixTree::compute_counts_dfs(Node* node) {
+        DepthFirst<Node> dfs;
+        dfs.run(node,
+            [](Node* n, Transition*) {
+                n->count = 0;
+                return true;
+            },
+            [&](Node* n, Transition*) {
+                if (n->leaf) {
+                    n->count = 1;
+                    for (Index e = n->shared; e >= 0; e = shared_suffixes[e].next) {
+                        ++n->count;
                     }
-                    match_len++;
                 }
-
-                pos += match_len;
-                current = trans.tgt;
-
-                // Si llegamos a una hoja, marcarla
-                if (current->g.empty()) {
-                    current->mark_string(string_id);
-                    break;
+                if (n != node) {
+                    n->parent->count += n->count;
                 }
-            }
+            });
+        return node->count;
+    }
+
+    /**
+     * propagate_color - Agrega string_id a node y sus ancestros
+     *
+     * Los colores de un padre contienen a los de sus hijos, así que se sube
+     * hasta el primer nodo que ya tiene el color. Cada nodo recibe cada
+     * color una sola vez: el costo total por string es O(nodos que toca).
+     */
+    void SuffixTree::propagate_color(Node* node, int string_id) {
+        while (node != nullptr and !node->colors.test(string_id - 1)) {
+            node->mark_string(string_id);
+            node = node->parent;
         }
     }
 
 
-    bool SuffixTree::contains_end_token(const std::string& str) const {
-        return str.find(END_TOKEN) != std::string::npos;
+    bool SuffixTree::is_removed(int id) const {
+        return static_cast<std::size_t>(id) < removed_ids.size() and removed_ids[id];
     }
 
-    void SuffixTree::get_all_strings_dfs(Node* node, std::string& current_path, std::unordered_map<ColorSet, std::vector<std::string>>& result) {
+    bool SuffixTree::contains_end_token(std::string_view str) const {
+        return str.find(END_TOKEN) != std::string_view::npos;
+    }
+
+    /**
+     * check_string - Verifica si str puede agregarse al árbol
+     */
+    SuffixTree::AddStatus SuffixTree::check_string(std::string_view str) const {
+        if (frozen) {
+            return AddStatus::Frozen;
+        }
+        if (stream_id != 0) {
+            return AddStatus::StreamOpen;
+        }
+        if (contains_end_token(str)) {
+            return AddStatus::ContainsEndToken;
+        }
+        if (text.size() + str.size() + 1 > static_cast<std::size_t>(std::numeric_limits<Index>::max())) {
+            return AddStatus::TooLong;
+        }
+        return AddStatus::Ok;
+    }
+
+    void SuffixTree::get_all_strings_dfs(const Node* node, std::string& current_path, std::unordered_map<ColorSet, std::vector<std::string>>& result) const {
         if (node == nullptr) {
             return;
         }
 
-        // Verificar los colores del nodo actual
-        ColorSet node_colors = node->colors;
-        int color_count = node_colors.count();
-
-        // Si el nodo tiene colores, procesarlo
-        if (color_count > 0) {
-            std::string to_store;
-            
-            if (color_count == 1) {
-                // Solo un color: guardar solo el primer carácter del path completo
-                if (!current_path.empty()) {
-                    to_store = std::string(1, current_path[0]);
-                } else {
-                    to_store = "";  // Nodo raíz sin transición
-                }
-            } else {
-                // Múltiples colores: guardar el string completo
-                to_store = current_path;
-                // Eliminar END_TOKEN si está presente
-                if (!to_store.empty() && to_store.back() == END_TOKEN) {
-                    to_store.pop_back();
-                }
-            }
-            
-            // Guardar en el resultado
-            if (!to_store.empty() || color_count > 1) {
-                result[node_colors].push_back(to_store);
-            }
-        }
+        // Largo de current_path antes de entrar a cada nodo (para el backtrack)
+        std::vector<std::size_t> path_marks;
 
-        // Recorrer todas las transiciones (hijos)
-        for (auto& pair : node->g) {
-            Transition& trans = pair.second;
-            if (trans.tgt != nullptr) {
-                // Obtener el string de la transición
-                std::string edge_str = substring_to_string(trans.sub);
-                
-                // Agregar al path actual
-                current_path += edge_str;
-                
-                // Recursión
-                get_all_strings_dfs(trans.tgt, current_path, result);
-                
-                // Backtrack: remover del path
-                current_path.erase(current_path.length() - edge_str.length());
+        auto enter = [&](const Node* n, const Transition* trans) {
+            path_marks.push_back(current_path.size());
+            if (trans != nullptr) {
+                // Agregar al path actual el string de la transición
+                current_path += substring_to_string(trans->sub);
             }
-        }
-    }
 
+            // Verificar los colores del nodo actual
+            const ColorSet& node_colors = n->colors;
+            int color_count = node_colors.count();
 
+            // Si el nodo tiene colores, procesarlo
+            if (color_count > 0) {
+                std::string to_store;
 
+                if (color_count == 1) {
+                    // Solo un color: guardar solo el primer carácter del path completo
+                    if (!current_path.empty()) {
+                        to_store = std::string(1, current_path[0]);
+                    } else {
+                        to_store = "";  // Nodo raíz sin transición
+                    }
+                } else {
+                    // Múltiples colores: guardar el string completo
+                    to_store = current_path;
+                    // Eliminar END_TOKEN si está presente
+                    if (!to_store.empty() && to_store.back() == END_TOKEN) {
+                        to_store.pop_back();
+                    }
+                }
 
+                // Guardar en el resultado
+                if (!to_store.empty() || color_count > 1) {
+                    result[node_colors].push_back(to_store);
+                }
+            }
+            return true;
+        };
 
+        // Backtrack: remover del path la arista del nodo
+        auto leave = [&](const Node*, const Transition*) {
+            current_path.resize(path_marks.back());
+            path_marks.pop_back();
+        };
 
+        DepthFirst<const Node>().run(node, enter, leave);
+    }
 
 
 } // namespace aed::structure
\ No newline at end of file
@@ -2,14 +2,14 @@
 #include <vector>
 #include <limits>
 #include <iostream>
+#include <algorithm>
+#include <utility>
 
 namespace aed::structure {
 
     using Node            = SuffixTree::Node;
     using MappedSubstring = SuffixTree::MappedSubstring;
     using Transition      = SuffixTree::Transition;
-    using SinkNode        = SuffixTree::SinkNode;
-    using Leaf            = SuffixTree::Leaf;
     using ReferencePoint  = SuffixTree::ReferencePoint;
     using Base            = SuffixTree::Base;
     using Index           = SuffixTree::Index;
@@ -19,37 +19,89 @@ namespace aed::structure {
     //          IMPLEMENTACION PRINCIPAL PUBLIC
     // =====================================================
 
-    SuffixTree::SuffixTree() : last_index(0), colors_computed(false) {}
+    // Un árbol vacío ya tiene sus colores al día: add_string los mantiene
+    SuffixTree::SuffixTree()
+        : string_offsets{0}, free_shared(-1), dead_chars(0), last_index(0),
+          colors_computed(true), counts_computed(true), frozen(false),
+          stream_id(0), stream_point(&tree.root, 0, 0), stream_leaves(nullptr) {}
 
-    int SuffixTree::add_string(const std::string &str) {
-        if (contains_end_token(str)) {
-            std::cerr << "Error: El string contiene el token terminal '"
-                     << END_TOKEN << "'" << std::endl;
-            return -1;
-        }
+    /**
+     * clear - Elimina todos los strings y nodos del árbol
+     *
+     * Devuelve los bloques de la arena y deja el árbol como recién construido.
+     */
+    void SuffixTree::clear() {
+        tree.clean();
+        text.clear();
+        string_offsets.assign(1, 0);
+        shared_suffixes.clear();
+        shared_at.clear();
+        free_shared = -1;
+        removed_ids.clear();
+        dead_chars = 0;
+        last_index = 0;
+        colors_computed = true;
+        counts_computed = true;
+        frozen = false;
+        stream_id = 0;
+        stream_leaves = nullptr;
+    }
 
-        if (last_index >= MAX_STRINGS) {
-            std::cerr << "Error: Límite de strings alcanzado ("
-                     << MAX_STRINGS << ")" << std::endl;
+    /**
+     * add_string - Agrega un string al árbol
+     *
+     * @return ID del string, o -1 si no pudo agregarse (ver AddStatus)
+     */
+    int SuffixTree::add_string(std::string_view str) {
+        if (check_string(str) != AddStatus::Ok) {
             return -1;
         }
 
-        ++last_index;
+        // Agregar el string (con token terminal) al buffer de texto
+        int sindex = store_string(str);
 
-        // Agregar token terminal
-        std::string s = str + END_TOKEN;
-        haystack[last_index] = s;
+        // Desplegar sufijos (los colores se actualizan durante el despliegue)
+        deploy_suffixes(sindex);
 
-        // Desplegar sufijos
-        if (deploy_suffixes(s, last_index) < 0) {
-            haystack.erase(last_index);
-            --last_index;
-            return -1;
+        return last_index;
+    }
+
+    /**
+     * add_strings - Agrega varios strings de una vez
+     *
+     * Reserva text una sola vez y no copia los strings más que al buffer.
+     * Al terminar los colores quedan calculados: si ya estaban al día se
+     * mantienen en cada despliegue (más barato que recalcular, los nodos
+     * recién tocados siguen en caché); si no, se calculan con una sola
+     * pasada al final.
+     *
+     * @return un AddResult por string, en el mismo orden
+     */
+    std::vector<SuffixTree::AddResult> SuffixTree::add_strings(std::span<const std::string_view> strs) {
+        std::vector<AddResult> results;
+        results.reserve(strs.size());
+
+        std::size_t total = text.size();
+        for (std::string_view s : strs) {
+            total += s.size() + 1;
+        }
+        text.reserve(std::min(total, static_cast<std::size_t>(std::numeric_limits<Index>::max())));
+        string_offsets.reserve(string_offsets.size() + strs.size());
+
+        for (std::string_view s : strs) {
+            AddStatus status = check_string(s);
+            if (status != AddStatus::Ok) {
+                results.push_back({-1, status});
+                continue;
+            }
+            int sindex = store_string(s);
+            deploy_suffixes(sindex);
+            results.push_back({sindex, AddStatus::Ok});
         }
 
-        colors_computed = false;  // Invalidar colores
+        compute_colors();
 
-        return last_index;
+        return results;
     }
 
 
@@ -57,35 +109,120 @@ namespace aed::structure {
     /**
      * compute_colors - Calcula los colores de todos los nodos
      *
-     * Debe llamarse después de agregar todos los strings y antes de
-     * buscar distinguishing substrings.
+     * add_string mantiene los colores al día, así que solo recalcula
+     * (una pasada post-order) si colors_computed fue invalidado. No hace
+     * nada con un string abierto (sus hojas todavía no tienen largo).
      */
     void SuffixTree::compute_colors() {
-        if (colors_computed) {
+        if (colors_computed or stream_id != 0) {
             return;  // Ya están calculados
         }
 
-        // Primero marcar todas las hojas
-        for (int i = 1; i <= last_index; ++i) {
-            mark_leaves_for_string(i);
-        }
-
-        // Luego propagar colores desde las hojas hacia arriba
+        // Las hojas ya tienen sus colores: propagar hacia la raíz
         compute_colors_dfs(&tree.root);
 
         colors_computed = true;
     }
 
+    /**
+     * compute_counts - Calcula las apariciones de cada nodo
+     *
+     * A diferencia de los colores, los conteos no se mantienen al insertar
+     * (cada hoja nueva cambia todos sus ancestros): cualquier string nuevo
+     * los invalida y se recalculan en una pasada post-order. No hace nada
+     * con un string abierto.
+     */
+    void SuffixTree::compute_counts() {
+        if (counts_computed or stream_id != 0) {
+            return;
+        }
+        compute_counts_dfs(&tree.root);
+        counts_computed = true;
+    }
 
+    /**
+     * freeze - Deja el árbol listo para consultas concurrentes
+     *
+     * Calcula colores y conteos, compacta el texto de los strings quitados
+     * (compact_text) y rechaza nuevos strings (AddStatus::Frozen) y
+     * remove_string hasta clear(). Desde ahí nada escribe en el árbol
+     * (tampoco save()): is_suffix, is_substring, query_batch, find_all, count,
+     * document_frequency, get_all_strings, distinguishing_substrings,
+     * longest_common_substring, matching_statistics, find_approximate y
+     * find_regex pueden llamarse desde varios hilos sobre un
+     * `const SuffixTree&` sin sincronización.
+     *
+     * @return false (y el árbol no se congela) si hay un string abierto
+     */
+    bool SuffixTree::freeze() {
+        if (stream_id != 0) {
+            return false;
+        }
+        compute_colors();
+        compute_counts();
+        if (dead_chars > 0) {
+            compact_text();
+        }
+        frozen = true;
+        return true;
+    }
 
+    bool SuffixTree::is_frozen() const {
+        return frozen;
+    }
 
+    /**
+     * count - Cantidad de apariciones de pattern en todos los strings
+     *
+     * O(m) con el conteo del locus. No recalcula nada: cualquier string
+     * nuevo invalida los conteos, y hasta compute_counts() (o freeze)
+     * devuelve -1. También -1 con un string abierto.
+     */
+    int SuffixTree::count(std::string_view pattern) const {
+        if (!counts_computed or stream_id != 0) {
+            return -1;
+        }
+        if (pattern.empty() or contains_end_token(pattern)) {
+            return 0;
+        }
+        const Node* locus = find_locus(pattern);
+        return locus == nullptr ? 0 : locus->count;
+    }
 
-    std::unordered_map<ColorSet, std::vector<std::string>> SuffixTree::get_all_strings(Node* node) {
-        // Asegurar que los colores estén computados
-        if (!colors_computed) {
-            compute_colors();
+    /**
+     * document_frequency - Cantidad de strings distintos que contienen pattern
+     *
+     * Es la cantidad de colores del locus: O(m). Los colores se mantienen
+     * al insertar y quitar strings; si se invalidaron devuelve -1 hasta
+     * compute_colors() (o freeze), sin recalcular. También -1 con un string
+     * abierto.
+     */
+    int SuffixTree::document_frequency(std::string_view pattern) const {
+        if (!colors_computed or stream_id != 0) {
+            return -1;
         }
-        
+        if (pattern.empty() or contains_end_token(pattern)) {
+            return 0;
+        }
+        const Node* locus = find_locus(pattern);
+        return locus == nullptr ? 0 : static_cast<int>(locus->colors.count());
+    }
+
+
+
+
+
+    /**
+     * get_all_strings - Substrings del subárbol de node agrupados por
+     * colores. No recalcula colores: vacío si no están al día (ver
+     * compute_colors; siempre lo están después de freeze) o hay un string
+     * abierto
+     */
+    std::unordered_map<ColorSet, std::vector<std::string>> SuffixTree::get_all_strings(const Node* node) const {
+        if (!colors_computed or stream_id != 0) {
+            return {};
+        }
+
         std::unordered_map<ColorSet, std::vector<std::string>> result;
         std::string current_path = "";
         
@@ -101,41 +238,74 @@ namespace aed::structure {
 
 
 
-    bool SuffixTree::is_suffix(const std::string& str) {
-        if (contains_end_token(str)) {
+    /**
+     * is_suffix - Verifica si str es sufijo de algún string
+     *
+     * Baja por str y después verifica un END_TOKEN virtual: el carácter
+     * siguiente en la arista, o una transición con END_TOKEN si str
+     * termina justo en un nodo. No reserva memoria ni modifica el árbol,
+     * así que puede llamarse desde varios hilos a la vez.
+     *
+     * Con un string abierto (begin_string) devuelve false: sus hojas
+     * todavía no tienen largo.
+     */
+    bool SuffixTree::is_suffix(std::string_view str) const {
+        if (stream_id != 0 or contains_end_token(str)) {
             return false;
         }
 
-        std::string s = str + END_TOKEN;
-        ReferencePoint root_point(&tree.root, -1, 0);
-
-        return (get_starting_node(s, &root_point) == std::numeric_limits<Index>::max());
+        Index next;
+        const Node* locus = find_locus(str, &next);
+        if (locus == nullptr) {
+            return false;
+        }
+        if (next >= 0) {
+            return text[next] == END_TOKEN;
+        }
+        return locus->children().find(END_TOKEN) != nullptr;
     }
 
-    bool SuffixTree::is_substring(const std::string& str) {
-        if (contains_end_token(str)) {
+    /**
+     * is_substring - Verifica si str aparece en algún string
+     *
+     * Sin reservas de memoria y de solo lectura (ver is_suffix). False con
+     * un string abierto.
+     */
+    bool SuffixTree::is_substring(std::string_view str) const {
+        if (stream_id != 0 or contains_end_token(str)) {
             return false;
         }
+        return find_locus(str) != nullptr;
+    }
 
-        ReferencePoint root_point(&tree.root, -1, 0);
-
-        return (get_starting_node(str, &root_point) == std::numeric_limits<Index>::max());
+    /**
+     * find_all - Todas las apariciones de pattern (ver la versión con callback)
+     */
+    std::vector<Occurrence> SuffixTree::find_all(std::string_view pattern) const {
+        std::vector<Occurrence> result;
+        find_all(pattern, [&](const Occurrence& occ) {
+            result.push_back(occ);
+        });
+        return result;
     }
 
     int SuffixTree::get_string_count() const {
         return last_index;
     }
 
-    std::string SuffixTree::get_string(int id) const {
-        auto it = haystack.find(id);
-        if (it != haystack.end()) {
-            std::string result = it->second;
-            if (!result.empty() && result.back() == END_TOKEN) {
-                result.pop_back();
-            }
-            return result;
+    /**
+     * get_string - Vista (sin copia) del string id, sin el END_TOKEN
+     *
+     * La vista se invalida al agregar o quitar strings. Vacía si id fue
+     * quitado con remove_string.
+     */
+    std::string_view SuffixTree::get_string(int id) const {
+        if (id <= 0 or id > last_index or is_removed(id)) {
+            return {};
         }
-        return "";
+        Index begin = string_offsets[id - 1];
+        Index end = string_offsets[id] - 1;  // excluir END_TOKEN
+        return std::string_view(text).substr(begin, end - begin);
     }
 
 
@@ -0,0 +1,80 @@
+#include "../include/SuffixTree.h"
+#include <vector>
+
+namespace aed::structure {
+
+    using Node       = SuffixTree::Node;
+    using Transition = SuffixTree::Transition;
+    using Index      = SuffixTree::Index;
+    using Mask       = RegexNfa::Mask;
+
+    // =====================================================
+    //          BUSQUEDA POR EXPRESION REGULAR
+    // =====================================================
+
+    /**
+     * find_regex - Apariciones de una expresión regular restringida
+     *
+     * Compila regex a un RegexNfa (clases, comodines y huecos acotados,
+     * ver RegexNfa.h) y lo corre sobre las etiquetas de las aristas desde
+     * root: cada camino deletrea los sufijos que lo comparten, así que los
+     * prefijos comunes se leen una sola vez. Una rama se poda cuando el
+     * autómata se queda sin estados activos o llega a END_TOKEN, y al
+     * primer estado de aceptación se reporta todo el subárbol, sin bajar
+     * más.
+     *
+     * Cada posición de inicio se reporta una vez, con su match más corto.
+     *
+     * @param max_gap: repeticiones máximas de `*` y `+`
+     * @return (string_id, offset, length) ordenados por string y offset;
+     *         vacío si regex es inválida o hay un string abierto
+     */
+    std::vector<SubstringRef> SuffixTree::find_regex(std::string_view regex, int max_gap) const {
+        std::vector<SubstringRef> result;
+        RegexNfa nfa;
+        if (!nfa.compile(regex, max_gap) or stream_id != 0) {
+            return result;
+        }
+
+        struct Frame {
+            const Node* node;
+            Mask active;
+        };
+        std::vector<Frame> stack{{&tree.root, nfa.start()}};
+
+        while (!stack.empty()) {
+            Frame f = stack.back();
+            stack.pop_back();
+            for (auto&& child : f.node->children()) {
+                const Transition& t = child.second;
+                Index depth = f.node->depth;
+                Index end = t.tgt->depth;
+                Mask active = f.active;
+                const char* c = text.data() + t.sub.l;
+
+                while (depth < end and active != 0 and !nfa.accepts(active)) {
+                    active = *c == END_TOKEN ? 0 : nfa.step(active, *c);
+                    ++c;
+                    ++depth;
+                }
+
+                if (nfa.accepts(active)) {
+                    auto push = [&](const Occurrence& occ) {
+                        result.push_back({occ.string_id, occ.offset, depth});
+                    };
+                    report_subtree(t.tgt, push);
+                } else if (active != 0) {
+                    // Arista completa sin END_TOKEN: t.tgt es interno
+                    stack.push_back({t.tgt, active});
+                }
+            }
+        }
+
+        std::sort(result.begin(), result.end(), [](const SubstringRef& a, const SubstringRef& b) {
+            return a.string_id != b.string_id ? a.string_id < b.string_id : a.offset < b.offset;
+        });
+        return result;
+    }
+
+
+} // namespace aed::structure
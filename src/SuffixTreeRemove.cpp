@@ -0,0 +1,200 @@
+#include "../include/SuffixTree.h"
+#include "../include/TreeTraversal.h"
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace aed::structure {
+
+    using Node            = SuffixTree::Node;
+    using MappedSubstring = SuffixTree::MappedSubstring;
+    using Transition      = SuffixTree::Transition;
+    using Index           = SuffixTree::Index;
+
+    // =====================================================
+    //          ELIMINACION DE STRINGS
+    // =====================================================
+
+    /**
+     * remove_string - Quita el string id del árbol
+     *
+     * Solo recorre los nodos que tienen el color de id (los caminos de sus
+     * sufijos), de abajo hacia arriba:
+     *  - Cada sufijo de id es una hoja propia o una entrada en la lista de
+     *    otra hoja (que se desencadena). Una hoja propia compartida pasa al
+     *    primer string de su lista; si no, se borra.
+     *  - Un nodo interno que queda sin hijos se borra, y uno que queda con
+     *    un solo hijo se fusiona con él.
+     *  - Las aristas que apuntaban al texto de id se reescriben sobre otra
+     *    aparición de la misma etiqueta, tomada de un hijo.
+     *  - Los colores, y los conteos si estaban al día, se descuentan en el
+     *    mismo recorrido.
+     * Ningún suffix link queda apuntando a un nodo borrado: si cα sigue
+     * teniendo dos hijos, α también.
+     *
+     * El costo es proporcional a los nodos que toca id, no al árbol (si
+     * los colores no estaban calculados, primero se calculan). El texto de
+     * id queda en text sin referencias hasta que el texto muerto supera al
+     * vivo y se compacta (ver compact_text), así que amortizado también es
+     * proporcional a lo quitado.
+     *
+     * Los IDs no se reutilizan: get_string(id) devuelve vacío y
+     * get_string_count() sigue siendo el ID más alto asignado.
+     *
+     * @return false si id no existe o ya fue quitado, o si el árbol está
+     *         congelado o tiene un string abierto
+     */
+    bool SuffixTree::remove_string(int id) {
+        if (id <= 0 or id > last_index or is_removed(id) or frozen or stream_id != 0) {
+            return false;
+        }
+        compute_colors();
+
+        std::size_t color = static_cast<std::size_t>(id - 1);
+        Index end = string_offsets[id];
+
+        // Nodos con el color de id, en pre-order. key es el primer carácter
+        // de la arista que llega al nodo (text no cambia hasta el final)
+        struct Visit {
+            Node* node;
+            char key;
+            std::size_t parent;     // posición del padre en visits
+            Index removed;          // sufijos de id en el subárbol
+        };
+        std::vector<Visit> visits;
+        std::vector<std::size_t> open;
+
+        DepthFirst<Node>().run(&tree.root,
+            [&](Node* n, Transition* trans) {
+                if (!n->colors.test(color)) {
+                    return false;
+                }
+                std::size_t parent = open.empty() ? 0 : open.back();
+                open.push_back(visits.size());
+                visits.push_back({n, trans != nullptr ? text[trans->sub.l] : '\0', parent, 0});
+                return true;
+            },
+            [&](Node* n, Transition*) {
+                if (n->colors.test(color)) {
+                    open.pop_back();
+                }
+            });
+
+        // En orden inverso cada nodo se procesa después de todo su subárbol
+        for (std::size_t i = visits.size(); i-- > 1;) {
+            Visit& v = visits[i];
+            Node* n = v.node;
+            Node* parent = n->parent;
+            bool erased = false;
+
+            if (n->leaf) {
+                v.removed = 1;
+                if (n->string_id != id) {
+                    unlink_shared(n, shared_at.at(end - n->depth));
+                } else if (n->shared >= 0) {
+                    SharedSuffix heir = shared_suffixes[n->shared];
+                    unlink_shared(n, n->shared);
+                    n->string_id = heir.string_id;
+                    n->suffix_start = heir.start;
+                    parent->children().find(v.key)->sub = MappedSubstring(heir.string_id, heir.start + parent->depth,
+                                                                 std::numeric_limits<Index>::max());
+                } else {
+                    parent->children().erase(v.key);
+                    tree.arena.free_node(n);
+                    erased = true;
+                }
+            } else if (n->children().empty()) {
+                parent->children().erase(v.key);
+                tree.arena.free_node(n);
+                erased = true;
+            } else if (n->children().size() == 1) {
+                // La arista del único hijo se alarga hacia arriba sobre su propio texto
+                Transition lower = (*n->children().begin()).second;
+                lower.sub.l -= n->depth - parent->depth;
+                lower.tgt->parent = parent;
+                parent->children().set(v.key, lower);
+                tree.arena.free_node(n);
+                erased = true;
+            } else {
+                Transition* up = parent->children().find(v.key);
+                if (up->sub.ref_str == id) {
+                    const MappedSubstring& below = (*n->children().begin()).second.sub;
+                    up->sub = MappedSubstring(below.ref_str, below.l - (n->depth - parent->depth), below.l - 1);
+                }
+            }
+
+            if (!erased) {
+                n->colors.reset(color);
+                n->count -= v.removed;
+            }
+            visits[v.parent].removed += v.removed;
+        }
+        tree.root.colors.reset(color);
+        tree.root.count -= visits[0].removed;
+
+        if (removed_ids.size() <= static_cast<std::size_t>(last_index)) {
+            removed_ids.resize(last_index + 1, false);
+        }
+        removed_ids[id] = true;
+        dead_chars += end - string_offsets[id - 1];
+        if (dead_chars > static_cast<Index>(text.size()) - dead_chars) {
+            compact_text();
+        }
+        return true;
+    }
+
+    /**
+     * compact_text - Quita de text el texto de los strings eliminados
+     *
+     * Cada string vivo se corre hacia atrás lo que ocupaban los eliminados
+     * anteriores: como toda arista apunta al string de su ref_str (y toda
+     * hoja o SharedSuffix al de su string_id), el corrimiento de cada
+     * posición sale de una tabla por ID. Los eliminados quedan con rango
+     * vacío en string_offsets. O(#nodos + |text|).
+     */
+    void SuffixTree::compact_text() {
+        std::vector<Index> shift(last_index + 1, 0);
+        std::vector<Index> offsets{0};
+        offsets.reserve(string_offsets.size());
+        std::string compacted;
+        compacted.reserve(text.size() - dead_chars);
+
+        for (int id = 1; id <= last_index; ++id) {
+            Index begin = string_offsets[id - 1];
+            shift[id] = begin - static_cast<Index>(compacted.size());
+            if (!is_removed(id)) {
+                compacted.append(text, begin, string_offsets[id] - begin);
+            }
+            offsets.push_back(static_cast<Index>(compacted.size()));
+        }
+
+        DepthFirst<Node>().run(&tree.root, [&](Node* n, Transition* trans) {
+            if (trans != nullptr) {
+                Index by = shift[trans->sub.ref_str];
+                trans->sub.l -= by;
+                if (trans->sub.r != std::numeric_limits<Index>::max()) {
+                    trans->sub.r -= by;
+                }
+            }
+            if (n->leaf) {
+                n->suffix_start -= shift[n->string_id];
+            }
+            return true;
+        });
+
+        shared_at.clear();
+        for (Index e = 0; e < static_cast<Index>(shared_suffixes.size()); ++e) {
+            SharedSuffix& occ = shared_suffixes[e];
+            if (occ.string_id != 0) {
+                occ.start -= shift[occ.string_id];
+                shared_at[occ.start] = e;
+            }
+        }
+
+        text = std::move(compacted);
+        string_offsets = std::move(offsets);
+        dead_chars = 0;
+    }
+
+
+} // namespace aed::structure
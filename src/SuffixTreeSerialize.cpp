@@ -0,0 +1,155 @@
+#include "../include/SuffixTree.h"
+#include "../include/FlatTreeFormat.h"
+#include "../include/TreeTraversal.h"
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+namespace aed::structure {
+
+    using Node       = SuffixTree::Node;
+    using Transition = SuffixTree::Transition;
+
+    // =====================================================
+    //          SERIALIZACION
+    // =====================================================
+
+    /**
+     * save - Escribe el árbol en el formato plano de FlatTreeFormat.h
+     *
+     * Antes calcula colores y conteos si no estaban al día y compacta el
+     * texto de los strings quitados (en el archivo quedan con rango vacío
+     * en string_offsets). Un árbol congelado ya está compactado (freeze lo
+     * hace), así que save() no lo modifica y puede correr junto a las
+     * consultas de otros hilos sin invalidar los string_view de
+     * get_string. Los nodos se numeran en pre-order (un recorrido con pila
+     * explícita) y cada puntero pasa a ser un índice; el archivo se abre
+     * después con MappedSuffixTree sin reconstruir nada. Solo las hojas
+     * escriben su lista de colores (ver FlatTreeFormat.h).
+     *
+     * @return false si no se pudo escribir el archivo o hay un string
+     *         abierto (begin_string sin finish_string)
+     */
+    bool SuffixTree::save(const std::string& path) {
+        if (stream_id != 0) {
+            return false;
+        }
+        compute_colors();
+        compute_counts();
+        if (!frozen and dead_chars > 0) {
+            compact_text();
+        }
+
+        std::vector<flat::Node> nodes;
+        std::vector<flat::Edge> edges;
+        std::vector<std::int32_t> colors;
+
+        // Por cada nodo abierto en el recorrido: su índice y la próxima arista libre
+        struct Open {
+            std::int32_t id;
+            std::int32_t next_edge;
+        };
+        std::vector<Open> open;
+
+        DepthFirst<const Node>().run(&tree.root,
+            [&](const Node* n, const Transition* trans) {
+                std::int32_t id = static_cast<std::int32_t>(nodes.size());
+                if (trans != nullptr) {
+                    flat::Edge& e = edges[open.back().next_edge++];
+                    e.label = trans->sub.l;
+                    e.target = id;
+                    e.c = text[trans->sub.l];
+                }
+
+                flat::Node fn{};
+                fn.depth = n->depth;
+                fn.first_edge = static_cast<std::int32_t>(edges.size());
+                fn.edge_count = static_cast<std::int32_t>(n->children().size());
+                fn.count = n->count;
+                fn.documents = static_cast<std::int32_t>(n->colors.count());
+                fn.color_begin = static_cast<std::int32_t>(colors.size());
+                if (n->leaf) {
+                    for (std::size_t c : n->colors) {
+                        colors.push_back(static_cast<std::int32_t>(c));
+                    }
+                }
+                fn.color_count = static_cast<std::int32_t>(colors.size()) - fn.color_begin;
+                fn.suffix_start = n->leaf ? n->suffix_start : 0;
+                fn.string_id = n->leaf ? n->string_id : 0;
+                fn.shared = n->leaf ? n->shared : -1;
+                nodes.push_back(fn);
+
+                edges.resize(edges.size() + n->children().size(), flat::Edge{});
+                open.push_back({id, fn.first_edge});
+                return true;
+            },
+            [&](const Node*, const Transition*) {
+                flat::Node& fn = nodes[open.back().id];
+                fn.subtree_end = static_cast<std::int32_t>(nodes.size());
+                std::sort(edges.begin() + fn.first_edge, edges.begin() + fn.first_edge + fn.edge_count,
+                          [](const flat::Edge& a, const flat::Edge& b) {
+                              return static_cast<unsigned char>(a.c) < static_cast<unsigned char>(b.c);
+                          });
+                open.pop_back();
+            });
+
+        std::vector<flat::Shared> shared;
+        shared.reserve(shared_suffixes.size());
+        for (const SharedSuffix& s : shared_suffixes) {
+            shared.push_back({s.string_id, s.start, s.next});
+        }
+
+        // Secciones en orden, cada una alineada a 8 bytes
+        struct Payload {
+            const void* data;
+            std::size_t count;
+            std::size_t element_size;
+        };
+        const Payload payload[flat::SECTION_COUNT] = {
+            {text.data(), text.size(), sizeof(char)},
+            {string_offsets.data(), string_offsets.size(), sizeof(std::int32_t)},
+            {nodes.data(), nodes.size(), sizeof(flat::Node)},
+            {edges.data(), edges.size(), sizeof(flat::Edge)},
+            {shared.data(), shared.size(), sizeof(flat::Shared)},
+            {colors.data(), colors.size(), sizeof(std::int32_t)},
+        };
+
+        flat::Header header{};
+        std::copy(std::begin(flat::MAGIC), std::end(flat::MAGIC), header.magic);
+        header.version = flat::VERSION;
+        header.endian_tag = flat::ENDIAN_TAG;
+        header.header_size = sizeof(flat::Header);
+        header.node_size = sizeof(flat::Node);
+        header.edge_size = sizeof(flat::Edge);
+        header.end_token = static_cast<unsigned char>(END_TOKEN);
+        header.string_count = static_cast<std::uint32_t>(last_index);
+
+        flat::Checksum sum;
+        std::uint64_t offset = flat::align8(sizeof(flat::Header));
+        for (int s = 0; s < flat::SECTION_COUNT; ++s) {
+            std::size_t bytes = payload[s].count * payload[s].element_size;
+            header.sections[s] = {offset, payload[s].count};
+            sum.update(payload[s].data, bytes);
+            offset += flat::align8(bytes);
+        }
+        header.file_size = offset;
+        header.checksum = sum.value();
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        static const char zeros[8] = {};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(zeros, flat::align8(sizeof(header)) - sizeof(header));
+        for (const Payload& p : payload) {
+            std::size_t bytes = p.count * p.element_size;
+            out.write(static_cast<const char*>(p.data), bytes);
+            out.write(zeros, flat::align8(bytes) - bytes);
+        }
+        return static_cast<bool>(out.flush());
+    }
+
+
+} // namespace aed::structure
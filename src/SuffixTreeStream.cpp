@@ -0,0 +1,254 @@
+#include "../include/SuffixTree.h"
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace aed::structure {
+
+    using Node           = SuffixTree::Node;
+    using Transition     = SuffixTree::Transition;
+    using ReferencePoint = SuffixTree::ReferencePoint;
+    using Index          = SuffixTree::Index;
+
+    // =====================================================
+    //          INGESTA POR PARTES (STREAMING)
+    // =====================================================
+
+    /**
+     * begin_string - Abre un string nuevo que se recibe por partes
+     *
+     * Ukkonen es en línea: cada append() extiende el árbol con sus
+     * caracteres apenas llegan, y finish_string() agrega el END_TOKEN.
+     * Los caracteres se copian una sola vez, directo a text. Mientras el
+     * string está abierto no se puede agregar otro ni consultar el árbol
+     * (las hojas del string abierto todavía no tienen largo).
+     */
+    SuffixTree::AddStatus SuffixTree::begin_string() {
+        AddStatus status = check_string({});
+        if (status != AddStatus::Ok) {
+            return status;
+        }
+        stream_id = last_index + 1;
+        stream_point = ReferencePoint(&tree.root, stream_id, static_cast<Index>(text.size()));
+        stream_leaves = nullptr;
+        counts_computed = false;
+        return AddStatus::Ok;
+    }
+
+    /**
+     * append - Agrega chunk al string abierto y extiende el árbol
+     *
+     * Si chunk contiene END_TOKEN o no entra en el rango de Index se
+     * rechaza completo y el string sigue abierto como estaba.
+     */
+    SuffixTree::AddStatus SuffixTree::append(std::string_view chunk) {
+        if (stream_id == 0) {
+            return AddStatus::NoStream;
+        }
+        if (contains_end_token(chunk)) {
+            return AddStatus::ContainsEndToken;
+        }
+        if (text.size() + chunk.size() + 1 > static_cast<std::size_t>(std::numeric_limits<Index>::max())) {
+            return AddStatus::TooLong;
+        }
+
+        Index begin = static_cast<Index>(text.size());
+        text.append(chunk);
+        extend_stream(begin, static_cast<Index>(text.size()));
+        return AddStatus::Ok;
+    }
+
+    /**
+     * extend_stream - Fases de Ukkonen para text[begin, end) del string abierto
+     *
+     * El punto activo se lleva en una variable local: como miembro se
+     * releía y escribía en memoria en cada carácter.
+     */
+    void SuffixTree::extend_stream(Index begin, Index end) {
+        ReferencePoint point = stream_point;
+        int id = stream_id;
+        for (Index i = begin; i < end; ++i) {
+            point = extend(point, id, i);
+        }
+        stream_point = point;
+    }
+
+    /**
+     * finish_string - Cierra el string abierto con END_TOKEN
+     *
+     * @return ID del string (el mismo que tendría con add_string)
+     */
+    SuffixTree::AddResult SuffixTree::finish_string() {
+        if (stream_id == 0) {
+            return {-1, AddStatus::NoStream};
+        }
+        int id = stream_id;
+
+        text.push_back(END_TOKEN);
+        string_offsets.push_back(static_cast<Index>(text.size()));
+        last_index = id;
+        stream_id = 0;
+
+        Index end = string_offsets[id];
+        while (stream_leaves != nullptr) {
+            Node* leaf = stream_leaves;
+            stream_leaves = leaf->suffix_link;
+            leaf->depth = end - leaf->suffix_start;
+            leaf->suffix_link = nullptr;
+        }
+
+        stream_point = extend(stream_point, id, end - 1);
+        mark_shared_suffixes(stream_point, id);
+        stream_point = ReferencePoint(&tree.root, 0, 0);
+
+        return {id, AddStatus::Ok};
+    }
+
+    /**
+     * discard_stream - Deshace el string abierto como si no se hubiera
+     * empezado
+     *
+     * Mientras el string está abierto Ukkonen solo agrega sus hojas
+     * (stream_leaves) y nodos que parten una arista para colgarlas, y la
+     * parte de arriba de cada arista partida conserva su texto. Alcanza
+     * con borrar esas hojas y, de abajo hacia arriba, borrar los nodos que
+     * quedaron sin hijos y fusionar los que quedaron con uno (como en
+     * remove_string). Después se recorta text; el ID no se consume y los
+     * colores de los nodos que quedan se descuentan. O(nodos que tocó el
+     * string).
+     */
+    void SuffixTree::discard_stream() {
+        std::size_t color = static_cast<std::size_t>(stream_id - 1);
+
+        // Ancestros de las hojas del string, con el inicio de un sufijo que
+        // pasa por cada uno (para leer el carácter de su arista)
+        std::unordered_map<Node*, Index> start_of;
+        std::vector<Node*> inner;
+        for (Node* leaf = stream_leaves; leaf != nullptr;) {
+            Node* next = leaf->suffix_link;
+            Index start = leaf->suffix_start;
+            for (Node* n = leaf->parent; n != &tree.root and start_of.emplace(n, start).second; n = n->parent) {
+                inner.push_back(n);
+            }
+            leaf->parent->children().erase(text[start + leaf->parent->depth]);
+            tree.arena.free_node(leaf);
+            leaf = next;
+        }
+
+        // Cada hijo es más profundo que su padre: se procesa antes
+        std::sort(inner.begin(), inner.end(), [](const Node* a, const Node* b) {
+            return a->depth > b->depth;
+        });
+        for (Node* n : inner) {
+            Node* parent = n->parent;
+            char key = text[start_of[n] + parent->depth];
+            if (n->children().empty()) {
+                parent->children().erase(key);
+                tree.arena.free_node(n);
+            } else if (n->children().size() == 1) {
+                // La arista partida vuelve a ser una sola, sobre el texto del hijo
+                Transition lower = (*n->children().begin()).second;
+                lower.sub.l -= n->depth - parent->depth;
+                lower.tgt->parent = parent;
+                parent->children().set(key, lower);
+                tree.arena.free_node(n);
+            } else {
+                n->colors.reset(color);
+            }
+        }
+        tree.root.colors.reset(color);
+
+        text.resize(string_offsets.back());
+        stream_id = 0;
+        stream_leaves = nullptr;
+        stream_point = ReferencePoint(&tree.root, 0, 0);
+    }
+
+    /**
+     * add_file - Agrega el contenido de un archivo como un string
+     *
+     * Lee de a chunk_size bytes directo al final de text (sin buffer
+     * intermedio; text se reserva una sola vez) y extiende el árbol con
+     * cada bloque antes de leer el siguiente. Si path no se puede
+     * posicionar (un pipe, un FIFO, /dev/stdin) text no se reserva por
+     * adelantado, pero se lee igual hasta EOF.
+     *
+     * Cada bloque se revisa (END_TOKEN) antes de extender el árbol con él.
+     * Si la lectura falla a mitad de camino, el archivo contiene END_TOKEN
+     * o no entra, lo ya extendido se deshace con discard_stream: no queda
+     * ningún string abierto, text, los IDs, los colores y los conteos
+     * quedan como antes de la llamada, y el próximo string recibe el ID
+     * que habría recibido el archivo.
+     *
+     * @return {-1, status} si no se agregó
+     */
+    SuffixTree::AddResult SuffixTree::add_file(const std::string& path, std::size_t chunk_size) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            return {-1, AddStatus::ReadFailed};
+        }
+        // begin_string invalida los conteos; al deshacer vuelven a valer
+        bool counts = counts_computed;
+        AddStatus status = begin_string();
+        if (status != AddStatus::Ok) {
+            return {-1, status};
+        }
+        chunk_size = std::max<std::size_t>(chunk_size, 1);
+
+        auto discard = [&](AddStatus error) {
+            discard_stream();
+            counts_computed = counts;
+            return AddResult{-1, error};
+        };
+
+        // Con el tamaño conocido, text crece una sola vez
+        std::streamoff file_size = -1;
+        if (in.seekg(0, std::ios::end)) {
+            file_size = in.tellg();
+            in.clear();
+            if (!in.seekg(0, std::ios::beg)) {
+                return discard(AddStatus::ReadFailed);
+            }
+        } else {
+            in.clear();     // no se puede posicionar: nada se consumió
+        }
+        // Un tamaño fuera de rango (un directorio puede informar cualquier
+        // cosa) no se reserva: la lectura decide si falla o no entra
+        if (file_size > 0 and text.size() + static_cast<std::size_t>(file_size) + 1 <=
+                              static_cast<std::size_t>(std::numeric_limits<Index>::max())) {
+            text.reserve(text.size() + static_cast<std::size_t>(file_size) + 1);
+        }
+
+        while (in) {
+            std::size_t old_size = text.size();
+            if (old_size + chunk_size + 1 > static_cast<std::size_t>(std::numeric_limits<Index>::max())) {
+                chunk_size = static_cast<std::size_t>(std::numeric_limits<Index>::max()) - old_size - 1;
+                if (chunk_size == 0) {
+                    if (in.peek() == std::ifstream::traits_type::eof()) {
+                        break;
+                    }
+                    return discard(AddStatus::TooLong);
+                }
+            }
+            text.resize(old_size + chunk_size);
+            in.read(text.data() + old_size, static_cast<std::streamsize>(chunk_size));
+            std::size_t got = static_cast<std::size_t>(in.gcount());
+            text.resize(old_size + got);
+            if (in.bad() or (in.fail() and !in.eof())) {
+                text.resize(old_size);
+                return discard(AddStatus::ReadFailed);
+            }
+            if (contains_end_token(std::string_view(text).substr(old_size))) {
+                text.resize(old_size);
+                return discard(AddStatus::ContainsEndToken);
+            }
+
+            extend_stream(static_cast<Index>(old_size), static_cast<Index>(text.size()));
+        }
+        return finish_string();
+    }
+
+
+} // namespace aed::structure
@@ -1,6 +1,8 @@
 #include "TreeVisualizer.h"
+#include "TreeTraversal.h"
 #include <cmath>
 #include <sstream>
+#include <utility>
 
 TreeVisualizer::TreeVisualizer() 
     : offsetX(50), offsetY(50), nodeRadius(25), 
@@ -13,27 +15,40 @@ TreeVisualizer::TreeVisualizer()
     }
 }
 
+// Ambos recorridos usan pila explicita (DepthFirst): en arboles muy
+// profundos ("aaaa...") la recursion desbordaba la pila.
+
 float TreeVisualizer::computeSubtreeWidth(
     aed::structure::SuffixTree::Node* node,
     std::unordered_map<aed::structure::SuffixTree::Node*, float>& widths)
 {
-    if (node->g.empty()) {
-        widths[node] = nodeRadius * 2;   // ancho mínimo
-        return widths[node];
-    }
+    using Node = aed::structure::SuffixTree::Node;
+    using Transition = aed::structure::SuffixTree::Transition;
+
+    // Post-order: el ancho de un nodo depende del de sus hijos
+    aed::structure::DepthFirst<Node>().run(node,
+        [](Node*, Transition*) { return true; },
+        [&](Node* n, Transition*) {
+            const auto& children = std::as_const(*n).children();
+            if (children.empty()) {
+                widths[n] = nodeRadius * 2;   // ancho mínimo
+                return;
+            }
 
-    float total = 0;
-    for (const auto& p : node->g) {
-        if (p.second.tgt) {
-            total += computeSubtreeWidth(p.second.tgt, widths);
-        }
-    }
+            float total = 0;
+            for (const auto& p : children) {
+                if (p.second.tgt) {
+                    total += widths[p.second.tgt];
+                }
+            }
 
-    // Separación levemente mayor entre subárboles
-    total += (node->g.size() - 1) * (horizontalSpacing / 2.0f);
+            // Separación levemente mayor entre subárboles
+            total += (children.size() - 1) * (horizontalSpacing / 2.0f);
 
-    widths[node] = total;
-    return total;
+            widths[n] = total;
+        });
+
+    return widths[node];
 }
 
 void TreeVisualizer::assignPositions(
@@ -43,22 +58,25 @@ void TreeVisualizer::assignPositions(
     std::unordered_map<aed::structure::SuffixTree::Node*, NodePosition>& pos,
     std::unordered_map<aed::structure::SuffixTree::Node*, float>& widths)
 {
-    pos[node] = {x, y};
-
-    if (node->g.empty()) return;
-
-    float totalWidth = widths[node];
-    float startX = x - totalWidth / 2.0f;
-
-    for (const auto& p : node->g) {
-        if (p.second.tgt) {
-            float w = widths[p.second.tgt];
-            float childX = startX + w / 2.0f;
-            assignPositions(p.second.tgt, childX, y + verticalSpacing, pos, widths);
-
+    using Node = aed::structure::SuffixTree::Node;
+    using Transition = aed::structure::SuffixTree::Transition;
+
+    // x donde empieza el próximo hijo de cada nodo ya ubicado
+    std::unordered_map<Node*, float> nextX;
+
+    aed::structure::DepthFirst<Node>().run(node, [&](Node* n, Transition*) {
+        float nx = x, ny = y;
+        if (n != node) {
+            float w = widths[n];
+            float& startX = nextX[n->parent];
+            nx = startX + w / 2.0f;
+            ny = pos[n->parent].y + verticalSpacing;
             startX += w + (horizontalSpacing / 2.0f);
         }
-    }
+        pos[n] = {nx, ny};
+        nextX[n] = nx - widths[n] / 2.0f;
+        return true;
+    });
 }
 
 
@@ -74,10 +92,10 @@ void TreeVisualizer::draw(sf::RenderWindow& window, aed::structure::SuffixTree&
     
     // Dibujar aristas primero (para que queden detrás de los nodos)
     for (const auto& posPair : positions) {
-        aed::structure::SuffixTree::Node* fromNode = posPair.first;
+        const aed::structure::SuffixTree::Node* fromNode = posPair.first;
         const NodePosition& fromPos = posPair.second;
         
-        for (const auto& transPair : fromNode->g) {
+        for (const auto& transPair : fromNode->children()) {
             if (transPair.second.tgt != nullptr) {
                 auto it = positions.find(transPair.second.tgt);
                 if (it != positions.end()) {
@@ -151,12 +169,10 @@ std::string TreeVisualizer::getNodeLabel(aed::structure::SuffixTree::Node* node)
     // Mostrar colores del nodo
     std::ostringstream oss;
     bool first = true;
-    for (size_t i = 0; i < aed::structure::SuffixTree::MAX_STRINGS; ++i) {
-        if (node->colors.test(i)) {
-            if (!first) oss << ",";
-            oss << (i + 1);
-            first = false;
-        }
+    for (std::size_t i : node->colors) {
+        if (!first) oss << ",";
+        oss << (i + 1);
+        first = false;
     }
     
     if (oss.str().empty()) {
@@ -0,0 +1,189 @@
+#include "SuffixTree.h"
+#include "TestUtil.h"
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Tests de find_approximate.
+ *
+ *  - Hamming y Edit con k = 0..3 coinciden con fuerza bruta sobre los
+ *    strings vivos, con altas y bajas al azar y patrones que solo
+ *    aparecerían cruzando el END_TOKEN entre dos strings.
+ *  - Patrones de más de 64 caracteres (varias palabras en la columna de
+ *    Myers).
+ *  - Vacío con pattern vacío, k < 0 o un string abierto.
+ */
+
+using aed::structure::ApproximateMatch;
+using aed::structure::SuffixTree;
+using namespace aed::test;
+using ErrorModel = SuffixTree::ErrorModel;
+
+// Substrings de largo |pattern| con k sustituciones o menos
+static std::vector<ApproximateMatch> naive_hamming(const std::vector<std::string>& strings,
+                                                   std::string_view pattern, int k) {
+    std::vector<ApproximateMatch> result;
+    int m = static_cast<int>(pattern.size());
+    for (std::size_t d = 0; d < strings.size(); ++d) {
+        const std::string& s = strings[d];
+        for (int off = 0; off + m <= static_cast<int>(s.size()); ++off) {
+            int errors = 0;
+            for (int i = 0; i < m; ++i) {
+                errors += s[off + i] != pattern[i];
+            }
+            if (errors <= k) {
+                result.push_back({static_cast<int>(d) + 1, off, m, errors});
+            }
+        }
+    }
+    return result;
+}
+
+// Para cada inicio, la menor distancia de edición entre pattern y un
+// substring no vacío que empieza ahí (y el largo más corto que la logra)
+static std::vector<ApproximateMatch> naive_edit(const std::vector<std::string>& strings,
+                                                std::string_view pattern, int k) {
+    std::vector<ApproximateMatch> result;
+    int m = static_cast<int>(pattern.size());
+    std::vector<int> col(m + 1), next(m + 1);
+    for (std::size_t d = 0; d < strings.size(); ++d) {
+        const std::string& s = strings[d];
+        for (int off = 0; off < static_cast<int>(s.size()); ++off) {
+            for (int i = 0; i <= m; ++i) {
+                col[i] = i;
+            }
+            int best = m + 1, best_length = 0;
+            for (int j = off; j < static_cast<int>(s.size()); ++j) {
+                next[0] = j - off + 1;
+                for (int i = 1; i <= m; ++i) {
+                    next[i] = std::min({col[i] + 1, next[i - 1] + 1, col[i - 1] + (s[j] != pattern[i - 1])});
+                }
+                std::swap(col, next);
+                if (col[m] < best) {
+                    best = col[m];
+                    best_length = j - off + 1;
+                }
+            }
+            if (best <= k) {
+                result.push_back({static_cast<int>(d) + 1, off, best_length, best});
+            }
+        }
+    }
+    return result;
+}
+
+// Patrón al azar: de un string (con cambios), cruzando el límite entre
+// dos strings, al azar, o con END_TOKEN
+static std::string random_pattern(const std::vector<std::string>& strings, std::mt19937& rng,
+                                  int sigma, std::size_t max_len) {
+    const std::string& s = strings[rng() % strings.size()];
+    const std::string& t = strings[rng() % strings.size()];
+    std::string p;
+    switch (rng() % 5) {
+    case 0:
+        p = random_string(rng, 1 + rng() % max_len, sigma);
+        break;
+    case 1:
+        // Fin de s y comienzo de t: solo está en el texto concatenado
+        p = s.substr(s.size() - std::min<std::size_t>(s.size(), 1 + rng() % 4)) + t.substr(0, 1 + rng() % 4);
+        break;
+    case 2:
+        p = s.substr(s.size() - std::min<std::size_t>(s.size(), 1 + rng() % 4)) + SuffixTree::END_TOKEN +
+            t.substr(0, rng() % 3);
+        break;
+    default: {
+        std::size_t from = rng() % (s.size() + 1);
+        p = s.substr(from, 1 + rng() % max_len);
+        for (int e = 0, n = static_cast<int>(rng() % 3); e < n and !p.empty(); ++e) {
+            std::size_t at = rng() % p.size();
+            switch (rng() % 3) {
+            case 0: p[at] = "abcd"[rng() % sigma]; break;
+            case 1: p.erase(at, 1); break;
+            default: p.insert(p.begin() + at, "abcd"[rng() % sigma]);
+            }
+        }
+    }
+    }
+    return p.empty() ? "a" : p;
+}
+
+// Las apariciones con a lo sumo k errores, de las calculadas para un k mayor
+static std::vector<ApproximateMatch> within(const std::vector<ApproximateMatch>& matches, int k) {
+    std::vector<ApproximateMatch> result;
+    std::copy_if(matches.begin(), matches.end(), std::back_inserter(result),
+                 [k](const ApproximateMatch& a) { return a.errors <= k; });
+    return result;
+}
+
+static void check_pattern(const SuffixTree& st, const std::vector<std::string>& strings, const std::string& p) {
+    std::vector<ApproximateMatch> hamming = naive_hamming(strings, p, 3);
+    std::vector<ApproximateMatch> edit = naive_edit(strings, p, 3);
+    for (int k = 0; k <= 3; ++k) {
+        CHECK(st.find_approximate(p, k, ErrorModel::Hamming) == within(hamming, k));
+        CHECK(st.find_approximate(p, k, ErrorModel::Edit) == within(edit, k));
+    }
+}
+
+static void test_against_naive(std::mt19937& rng) {
+    for (int iter = 0; iter < 200; ++iter) {
+        int sigma = 1 + static_cast<int>(rng() % 4);
+        SuffixTree st;
+        std::vector<std::string> strings;
+        for (int op = 0, n = 1 + static_cast<int>(rng() % 8); op < n; ++op) {
+            int id = 1 + static_cast<int>(rng() % (strings.size() + 1));
+            if (rng() % 4 == 0 and id <= static_cast<int>(strings.size())) {
+                CHECK(st.remove_string(id) == !strings[id - 1].empty());
+                strings[id - 1].clear();
+            } else {
+                std::string s = random_string(rng, 1 + rng() % 20, sigma);
+                CHECK(st.add_string(s) == static_cast<int>(strings.size()) + 1);
+                strings.push_back(s);
+            }
+            for (int q = 0; q < 3; ++q) {
+                check_pattern(st, strings, random_pattern(strings, rng, sigma, 8));
+            }
+        }
+    }
+}
+
+static void test_long_patterns(std::mt19937& rng) {
+    for (int iter = 0; iter < 10; ++iter) {
+        int sigma = 2 + static_cast<int>(rng() % 3);
+        SuffixTree st;
+        std::vector<std::string> strings;
+        for (int i = 0; i < 3; ++i) {
+            strings.push_back(random_string(rng, 100 + rng() % 100, sigma));
+            st.add_string(strings.back());
+        }
+        for (int q = 0; q < 4; ++q) {
+            check_pattern(st, strings, random_pattern(strings, rng, sigma, 140));
+        }
+    }
+}
+
+static void test_empty_results() {
+    SuffixTree st;
+    st.add_string("abcab");
+    CHECK(st.find_approximate("", 2).empty());
+    CHECK(st.find_approximate("ab", -1).empty());
+    CHECK(st.find_approximate("ab", -1, ErrorModel::Hamming).empty());
+
+    CHECK(st.begin_string() == SuffixTree::AddStatus::Ok);
+    CHECK(st.append("abd") == SuffixTree::AddStatus::Ok);
+    CHECK(st.find_approximate("ab", 1).empty());
+    CHECK(st.find_approximate("ab", 1, ErrorModel::Hamming).empty());
+    CHECK(st.finish_string().id == 2);
+    check_pattern(st, {"abcab", "abd"}, "abd");
+}
+
+int main() {
+    std::mt19937 rng(24);
+    test_against_naive(rng);
+    test_long_patterns(rng);
+    test_empty_results();
+    return report("test_approximate");
+}
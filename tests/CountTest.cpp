@@ -0,0 +1,114 @@
+#include "SuffixTree.h"
+#include "TestUtil.h"
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Tests del contrato de count: -1 mientras los conteos no están al día.
+ *
+ *  - Después de add_string, add_strings o add_strings_parallel count da -1
+ *    hasta compute_counts() o freeze(), y ahí coincide con fuerza bruta.
+ *  - Con un string abierto da -1, aunque se llame a compute_counts, y
+ *    sigue en -1 después de finish_string.
+ */
+
+using aed::structure::SuffixTree;
+using namespace aed::test;
+
+static void check_counts(const SuffixTree& st, const std::vector<std::string>& strings,
+                         std::mt19937& rng, int sigma) {
+    for (int q = 0; q < 20; ++q) {
+        std::string p = random_string(rng, 1 + rng() % 4, sigma);
+        CHECK(st.count(p) == static_cast<int>(naive_find_all(strings, p).size()));
+    }
+    CHECK(st.count("") == 0);
+    CHECK(st.count("a$") == 0);
+}
+
+static void check_stale(const SuffixTree& st) {
+    CHECK(st.count("a") == -1);
+    CHECK(st.count("") == -1);
+}
+
+static void test_add_invalidates(std::mt19937& rng) {
+    for (int iter = 0; iter < 100; ++iter) {
+        int sigma = 1 + static_cast<int>(rng() % 4);
+        SuffixTree st;
+        std::vector<std::string> strings;
+        check_counts(st, strings, rng, sigma);
+
+        for (int i = 0, n = 1 + static_cast<int>(rng() % 6); i < n; ++i) {
+            std::string s = random_string(rng, 1 + rng() % 15, sigma);
+            st.add_string(s);
+            strings.push_back(s);
+            check_stale(st);
+            if (rng() % 2 == 0) {
+                st.compute_counts();
+                check_counts(st, strings, rng, sigma);
+            }
+        }
+
+        std::vector<std::string> batch;
+        std::vector<std::string_view> views;
+        for (int i = 0, n = 1 + static_cast<int>(rng() % 4); i < n; ++i) {
+            batch.push_back(random_string(rng, 1 + rng() % 15, sigma));
+        }
+        for (const auto& s : batch) {
+            views.push_back(s);
+            strings.push_back(s);
+        }
+        if (iter % 2 == 0) {
+            st.add_strings(views);
+        } else {
+            st.add_strings_parallel(views, 2);
+        }
+        check_stale(st);
+
+        if (iter % 3 == 0) {
+            CHECK(st.freeze());
+        } else {
+            st.compute_counts();
+        }
+        check_counts(st, strings, rng, sigma);
+    }
+}
+
+static void test_open_stream(std::mt19937& rng) {
+    for (int iter = 0; iter < 50; ++iter) {
+        int sigma = 1 + static_cast<int>(rng() % 4);
+        SuffixTree st;
+        std::vector<std::string> strings;
+        for (int i = 0, n = static_cast<int>(rng() % 4); i < n; ++i) {
+            strings.push_back(random_string(rng, 1 + rng() % 15, sigma));
+            st.add_string(strings.back());
+        }
+        st.compute_counts();
+        check_counts(st, strings, rng, sigma);
+
+        std::string s = random_string(rng, 1 + rng() % 30, sigma);
+        CHECK(st.begin_string() == SuffixTree::AddStatus::Ok);
+        check_stale(st);
+        for (std::size_t pos = 0; pos < s.size();) {
+            std::size_t len = 1 + rng() % 5;
+            CHECK(st.append(std::string_view(s).substr(pos, len)) == SuffixTree::AddStatus::Ok);
+            pos += len;
+            st.compute_counts();
+            check_stale(st);
+        }
+        CHECK(st.finish_string().status == SuffixTree::AddStatus::Ok);
+        strings.push_back(s);
+        check_stale(st);
+
+        st.compute_counts();
+        check_counts(st, strings, rng, sigma);
+    }
+}
+
+int main() {
+    std::mt19937 rng(12);
+    test_add_invalidates(rng);
+    test_open_stream(rng);
+    return report("test_count");
+}
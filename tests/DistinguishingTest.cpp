@@ -0,0 +1,103 @@
+#include "SuffixTree.h"
+#include "TestUtil.h"
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * Tests de distinguishing_substrings.
+ *
+ *  - Con altas y bajas al azar coincide con fuerza bruta sobre los strings
+ *    vivos: un string quitado no tiene ninguno y deja de contar como
+ *    "otro" para los demás.
+ *  - Con un string abierto devuelve vacío, y al cerrarlo lo incluye.
+ */
+
+using aed::structure::SubstringRef;
+using aed::structure::SuffixTree;
+using namespace aed::test;
+
+// Para cada string vivo, sus substrings más cortos que no están en ningún
+// otro (uno por substring distinto, con su primera posición). Un string
+// quitado se representa vacío
+static std::vector<SubstringRef> naive_dsus(const std::vector<std::string>& strings) {
+    std::vector<SubstringRef> result;
+    for (std::size_t d = 0; d < strings.size(); ++d) {
+        const std::string& s = strings[d];
+        for (std::size_t len = 1; len <= s.size(); ++len) {
+            std::set<std::string> seen;
+            bool found = false;
+            for (std::size_t off = 0; off + len <= s.size(); ++off) {
+                std::string sub = s.substr(off, len);
+                if (!seen.insert(sub).second) {
+                    continue;
+                }
+                bool exclusive = true;
+                for (std::size_t e = 0; e < strings.size() and exclusive; ++e) {
+                    exclusive = e == d or strings[e].find(sub) == std::string::npos;
+                }
+                if (exclusive) {
+                    result.push_back({static_cast<int>(d) + 1, static_cast<int>(off), static_cast<int>(len)});
+                    found = true;
+                }
+            }
+            if (found) {
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+static void test_against_naive(std::mt19937& rng) {
+    for (int iter = 0; iter < 300; ++iter) {
+        int sigma = 1 + static_cast<int>(rng() % 4);
+        SuffixTree st;
+        std::vector<std::string> strings;
+        for (int op = 0, n = 1 + static_cast<int>(rng() % 12); op < n; ++op) {
+            int id = 1 + static_cast<int>(rng() % (strings.size() + 1));
+            if (rng() % 4 == 0 and id <= static_cast<int>(strings.size())) {
+                CHECK(st.remove_string(id) == !strings[id - 1].empty());
+                strings[id - 1].clear();
+            } else {
+                // A veces un string repetido o contenido en otro
+                std::string s = random_string(rng, 1 + rng() % 15, sigma);
+                if (rng() % 5 == 0 and !strings.empty()) {
+                    const std::string& other = strings[rng() % strings.size()];
+                    std::size_t from = rng() % (other.size() + 1);
+                    s = other.substr(from, 1 + rng() % 8);
+                    if (s.empty()) {
+                        s = "a";
+                    }
+                }
+                CHECK(st.add_string(s) == static_cast<int>(strings.size()) + 1);
+                strings.push_back(s);
+            }
+            CHECK(st.distinguishing_substrings() == naive_dsus(strings));
+        }
+    }
+}
+
+static void test_open_stream() {
+    SuffixTree st;
+    st.add_string("abab");
+    std::vector<std::string> strings{"abab"};
+    CHECK(st.distinguishing_substrings() == naive_dsus(strings));
+
+    CHECK(st.begin_string() == SuffixTree::AddStatus::Ok);
+    CHECK(st.distinguishing_substrings().empty());
+    CHECK(st.append("bba") == SuffixTree::AddStatus::Ok);
+    CHECK(st.distinguishing_substrings().empty());
+    CHECK(st.finish_string().id == 2);
+
+    strings.push_back("bba");
+    CHECK(st.distinguishing_substrings() == naive_dsus(strings));
+}
+
+int main() {
+    std::mt19937 rng(20);
+    test_against_naive(rng);
+    test_open_stream();
+    return report("test_distinguishing");
+}
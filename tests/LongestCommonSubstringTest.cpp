@@ -0,0 +1,126 @@
+#include "SuffixTree.h"
+#include "TestUtil.h"
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Tests de longest_common_substring.
+ *
+ *  - Con altas y bajas al azar, para k = 1..n coincide con fuerza bruta
+ *    sobre los strings vivos (largo máximo y primera aparición de cada
+ *    substring), y k mayor que la cantidad de strings vivos da vacío.
+ *  - Mismo resultado sobre un árbol armado con add_strings_parallel.
+ *  - Vacío con un string abierto.
+ */
+
+using aed::structure::SubstringRef;
+using aed::structure::SuffixTree;
+using namespace aed::test;
+
+// Substrings más largos que están en al menos k strings, en su primera
+// aparición (menor string y offset). Un string quitado se representa vacío
+static std::vector<SubstringRef> naive_lcs(const std::vector<std::string>& strings, int k) {
+    std::size_t longest = 0;
+    for (const auto& s : strings) {
+        longest = std::max(longest, s.size());
+    }
+    for (std::size_t len = longest; len > 0; --len) {
+        struct Seen {
+            std::set<int> docs;
+            SubstringRef first;
+        };
+        std::map<std::string, Seen> subs;
+        for (std::size_t d = 0; d < strings.size(); ++d) {
+            for (std::size_t off = 0; off + len <= strings[d].size(); ++off) {
+                auto [it, added] = subs.try_emplace(strings[d].substr(off, len));
+                if (added) {
+                    it->second.first = {static_cast<int>(d) + 1, static_cast<int>(off), static_cast<int>(len)};
+                }
+                it->second.docs.insert(static_cast<int>(d));
+            }
+        }
+        std::vector<SubstringRef> result;
+        for (const auto& [sub, seen] : subs) {
+            if (seen.docs.size() >= static_cast<std::size_t>(k)) {
+                result.push_back(seen.first);
+            }
+        }
+        if (!result.empty()) {
+            std::sort(result.begin(), result.end(), [](const SubstringRef& a, const SubstringRef& b) {
+                return a.string_id != b.string_id ? a.string_id < b.string_id : a.offset < b.offset;
+            });
+            return result;
+        }
+    }
+    return {};
+}
+
+static void check_all_k(const SuffixTree& st, const std::vector<std::string>& strings) {
+    int live = 0;
+    for (const auto& s : strings) {
+        live += !s.empty();
+    }
+    for (int k = 1; k <= live; ++k) {
+        CHECK(st.longest_common_substring(k) == naive_lcs(strings, k));
+    }
+    CHECK(st.longest_common_substring(live + 1).empty());
+    CHECK(st.longest_common_substring(live + 3).empty());
+    CHECK(st.longest_common_substring(0).empty());
+}
+
+static void test_against_naive(std::mt19937& rng) {
+    for (int iter = 0; iter < 300; ++iter) {
+        int sigma = 1 + static_cast<int>(rng() % 4);
+        SuffixTree st;
+        std::vector<std::string> strings;
+        for (int op = 0, n = 1 + static_cast<int>(rng() % 10); op < n; ++op) {
+            int id = 1 + static_cast<int>(rng() % (strings.size() + 1));
+            if (rng() % 4 == 0 and id <= static_cast<int>(strings.size())) {
+                CHECK(st.remove_string(id) == !strings[id - 1].empty());
+                strings[id - 1].clear();
+            } else {
+                std::string s = random_string(rng, 1 + rng() % 15, sigma);
+                CHECK(st.add_string(s) == static_cast<int>(strings.size()) + 1);
+                strings.push_back(s);
+            }
+            check_all_k(st, strings);
+        }
+    }
+}
+
+static void test_parallel_build(std::mt19937& rng) {
+    std::vector<std::string> strings;
+    std::vector<std::string_view> views;
+    for (int i = 0; i < 6; ++i) {
+        strings.push_back(random_string(rng, 20, 2));
+    }
+    views.assign(strings.begin(), strings.end());
+
+    SuffixTree st;
+    st.add_strings_parallel(views, 2);
+    check_all_k(st, strings);
+}
+
+static void test_open_stream() {
+    SuffixTree st;
+    st.add_string("abcab");
+    CHECK(st.begin_string() == SuffixTree::AddStatus::Ok);
+    CHECK(st.append("cabd") == SuffixTree::AddStatus::Ok);
+    CHECK(st.longest_common_substring(1).empty());
+    CHECK(st.longest_common_substring(2).empty());
+    CHECK(st.finish_string().id == 2);
+    check_all_k(st, {"abcab", "cabd"});
+}
+
+int main() {
+    std::mt19937 rng(21);
+    test_against_naive(rng);
+    test_parallel_build(rng);
+    test_open_stream();
+    return report("test_longest_common_substring");
+}
@@ -0,0 +1,133 @@
+#include "SuffixTree.h"
+#include "TestUtil.h"
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Tests de matching_statistics.
+ *
+ *  - out[j] coincide con el prefijo más largo de query[j..] presente en
+ *    algún string vivo (fuerza bruta), con queries que tienen END_TOKEN y
+ *    caracteres fuera del alfabeto, sobre árboles con strings quitados y
+ *    armados con add_strings_parallel (que rearma los suffix links).
+ *  - Devuelve false si out es más corto que query o hay un string abierto.
+ */
+
+using aed::structure::SuffixTree;
+using namespace aed::test;
+using Index = SuffixTree::Index;
+
+static Index naive_match(const std::vector<std::string>& strings, std::string_view query, std::size_t j) {
+    Index best = 0;
+    for (std::size_t len = 1; j + len <= query.size(); ++len) {
+        std::string_view p = query.substr(j, len);
+        if (p.back() == SuffixTree::END_TOKEN) {
+            break;
+        }
+        bool present = false;
+        for (std::size_t i = 0; i < strings.size() and !present; ++i) {
+            present = strings[i].find(p) != std::string::npos;
+        }
+        if (!present) {
+            break;
+        }
+        best = static_cast<Index>(len);
+    }
+    return best;
+}
+
+// Query al azar: sobre todo del alfabeto de los strings, con trozos
+// copiados de ellos para que haya coincidencias largas
+static std::string random_query(const std::vector<std::string>& strings, std::mt19937& rng, int sigma) {
+    static const char OTHER[] = {SuffixTree::END_TOKEN, 'x', '\0', '\xff'};
+    std::string q;
+    for (std::size_t n = rng() % 40; q.size() < n;) {
+        switch (rng() % 8) {
+        case 0:
+            q.push_back(OTHER[rng() % 4]);
+            break;
+        case 1:
+        case 2: {
+            const std::string& s = strings[rng() % strings.size()];
+            std::size_t from = rng() % (s.size() + 1);
+            q += s.substr(from, rng() % 12);
+            break;
+        }
+        default:
+            q += random_string(rng, 1, sigma);
+        }
+    }
+    return q;
+}
+
+static void check_query(const SuffixTree& st, const std::vector<std::string>& strings, std::string_view q) {
+    std::vector<Index> out(q.size() + 1, -7);
+    CHECK(st.matching_statistics(q, std::span<Index>(out.data(), q.size())));
+    for (std::size_t j = 0; j < q.size(); ++j) {
+        CHECK(out[j] == naive_match(strings, q, j));
+    }
+    CHECK(out[q.size()] == -7);
+    if (!q.empty()) {
+        CHECK(!st.matching_statistics(q, std::span<Index>(out.data(), q.size() - 1)));
+    }
+}
+
+static void test_against_naive(std::mt19937& rng) {
+    for (int iter = 0; iter < 300; ++iter) {
+        int sigma = 1 + static_cast<int>(rng() % 4);
+        SuffixTree st;
+        std::vector<std::string> strings;
+        for (int op = 0, n = 1 + static_cast<int>(rng() % 10); op < n; ++op) {
+            int id = 1 + static_cast<int>(rng() % (strings.size() + 1));
+            if (rng() % 4 == 0 and id <= static_cast<int>(strings.size())) {
+                CHECK(st.remove_string(id) == !strings[id - 1].empty());
+                strings[id - 1].clear();
+            } else {
+                std::string s = random_string(rng, 1 + rng() % 25, sigma);
+                CHECK(st.add_string(s) == static_cast<int>(strings.size()) + 1);
+                strings.push_back(s);
+            }
+            for (int q = 0; q < 5; ++q) {
+                check_query(st, strings, random_query(strings, rng, sigma));
+            }
+        }
+    }
+}
+
+static void test_parallel_build(std::mt19937& rng) {
+    for (int iter = 0; iter < 20; ++iter) {
+        int sigma = 1 + static_cast<int>(rng() % 4);
+        std::vector<std::string> strings;
+        for (int i = 0; i < 8; ++i) {
+            strings.push_back(random_string(rng, 1 + rng() % 40, sigma));
+        }
+        std::vector<std::string_view> views(strings.begin(), strings.end());
+        SuffixTree st;
+        st.add_strings_parallel(views, 3);
+        for (int q = 0; q < 20; ++q) {
+            check_query(st, strings, random_query(strings, rng, sigma));
+        }
+    }
+}
+
+static void test_open_stream() {
+    SuffixTree st;
+    st.add_string("abcab");
+    std::vector<Index> out(8);
+    CHECK(st.begin_string() == SuffixTree::AddStatus::Ok);
+    CHECK(st.append("bca") == SuffixTree::AddStatus::Ok);
+    CHECK(!st.matching_statistics("abc", out));
+    CHECK(st.finish_string().id == 2);
+    check_query(st, {"abcab", "bca"}, "cabca$bc");
+}
+
+int main() {
+    std::mt19937 rng(22);
+    test_against_naive(rng);
+    test_parallel_build(rng);
+    test_open_stream();
+    return report("test_matching_statistics");
+}
@@ -0,0 +1,95 @@
+#include "SuffixTree.h"
+#include "TestUtil.h"
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Tests de add_strings_parallel contra add_string secuencial.
+ *
+ * Con strings al azar (alfabetos chicos, muchos sufijos repetidos entre
+ * strings) y distinta cantidad de hilos verifica que:
+ *  - el árbol tenga la misma forma: mismas etiquetas de camino, las
+ *    mismas hojas y cada hoja del mismo string;
+ *  - find_all, count y document_frequency coincidan con fuerza bruta;
+ *  - la arena no guarde nodos que la fusión descartó;
+ *  - los strings con END_TOKEN se rechacen sin consumir ID, igual que
+ *    en add_string, y el árbol siga aceptando strings después.
+ */
+
+using aed::structure::SuffixTree;
+using namespace aed::test;
+
+// Etiqueta de camino de cada nodo -> string dueño (0 en nodos internos)
+static std::map<std::string, int> shape(SuffixTree& st) {
+    std::map<std::string, int> out;
+    std::vector<std::pair<const SuffixTree::Node*, std::string>> stack{{&st.tree.root, ""}};
+    while (!stack.empty()) {
+        auto [n, label] = stack.back();
+        stack.pop_back();
+        out[label] = n->leaf ? n->string_id : 0;
+        for (auto&& e : n->children()) {
+            stack.push_back({e.second.tgt, label + st.substring_to_string(e.second.sub)});
+        }
+    }
+    return out;
+}
+
+int main() {
+    std::mt19937 rng(9);
+    for (int iter = 0; iter < 300; ++iter) {
+        int sigma = 1 + static_cast<int>(rng() % 4);
+        std::vector<std::string> before, batch, after;
+        for (int i = 0, n = static_cast<int>(rng() % 3); i < n; ++i) {
+            before.push_back(random_string(rng, 1 + rng() % 10, sigma));
+        }
+        for (int i = 0, n = 1 + static_cast<int>(rng() % 30); i < n; ++i) {
+            batch.push_back(rng() % 15 == 0 ? "ab$c" : random_string(rng, 1 + rng() % 15, sigma));
+        }
+        for (int i = 0, n = static_cast<int>(rng() % 3); i < n; ++i) {
+            after.push_back(random_string(rng, 1 + rng() % 10, sigma));
+        }
+
+        SuffixTree seq, par;
+        std::vector<std::string> live;
+        for (const auto& s : before) {
+            seq.add_string(s);
+            par.add_string(s);
+            live.push_back(s);
+        }
+        std::vector<int> expected_ids;
+        for (const auto& s : batch) {
+            expected_ids.push_back(seq.add_string(s));
+            if (expected_ids.back() > 0) {
+                live.push_back(s);
+            }
+        }
+        std::vector<std::string_view> views(batch.begin(), batch.end());
+        auto results = par.add_strings_parallel(views, 1 + static_cast<unsigned>(rng() % 8));
+        CHECK(results.size() == batch.size());
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            CHECK(results[i].id == expected_ids[i]);
+        }
+        for (const auto& s : after) {
+            seq.add_string(s);
+            par.add_string(s);
+            live.push_back(s);
+        }
+
+        CHECK(shape(seq) == shape(par));
+        CHECK(par.tree.arena.size() == reachable_nodes(par));
+        CHECK(par.get_string_count() == seq.get_string_count());
+
+        par.compute_counts();
+        for (int q = 0; q < 40; ++q) {
+            std::string p = random_string(rng, 1 + rng() % 4, sigma);
+            Hits expected = naive_find_all(live, p);
+            CHECK(sorted_hits(par.find_all(p)) == expected);
+            CHECK(par.count(p) == static_cast<int>(expected.size()));
+            CHECK(par.document_frequency(p) == distinct_strings(expected));
+        }
+    }
+    return report("test_parallel_build");
+}
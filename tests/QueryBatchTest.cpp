@@ -0,0 +1,141 @@
+#include "SuffixTree.h"
+#include "TestUtil.h"
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Tests de query_batch.
+ *
+ *  - found[i] coincide con is_substring(patterns[i]) (y con fuerza bruta)
+ *    y el valor devuelto es la cantidad de aciertos, con lotes de más
+ *    patrones que carriles, duplicados, vacíos y patrones con END_TOKEN.
+ *  - Si found es más corto solo se responden los primeros patrones, sin
+ *    escribir fuera de found.
+ *  - Con un string abierto todos dan false y devuelve 0.
+ */
+
+using aed::structure::SuffixTree;
+using namespace aed::test;
+
+static bool naive_is_substring(const std::vector<std::string>& strings, std::string_view p) {
+    if (p.find(SuffixTree::END_TOKEN) != std::string_view::npos) {
+        return false;
+    }
+    for (const auto& s : strings) {
+        if (s.find(p) != std::string::npos) {
+            return true;
+        }
+    }
+    return p.empty();
+}
+
+// Patrones al azar: substrings de los strings, sus variantes y casos borde
+static std::vector<std::string> make_patterns(const std::vector<std::string>& strings,
+                                              std::mt19937& rng, int sigma) {
+    std::vector<std::string> patterns;
+    for (int i = 0, n = 1 + static_cast<int>(rng() % 60); i < n; ++i) {
+        const std::string& s = strings[rng() % strings.size()];
+        switch (rng() % 6) {
+        case 0:
+            patterns.push_back(random_string(rng, 1 + rng() % 6, sigma));
+            break;
+        case 1:
+            patterns.push_back("");
+            break;
+        case 2:
+            // Substring con END_TOKEN al final o en el medio
+            patterns.push_back(s.substr(rng() % (s.size() + 1)) + SuffixTree::END_TOKEN +
+                               (rng() % 2 ? "" : s.substr(0, rng() % (s.size() + 1))));
+            break;
+        case 3:
+            // Duplicado de uno anterior
+            patterns.push_back(patterns.empty() ? s : patterns[rng() % patterns.size()]);
+            break;
+        default: {
+            std::size_t from = rng() % (s.size() + 1);
+            patterns.push_back(s.substr(from, rng() % (s.size() - from + 1)) +
+                               (rng() % 3 == 0 ? random_string(rng, 1, sigma) : ""));
+            break;
+        }
+        }
+    }
+    return patterns;
+}
+
+static void check_batch(const SuffixTree& st, const std::vector<std::string>& strings,
+                        const std::vector<std::string>& patterns) {
+    std::vector<std::string_view> views(patterns.begin(), patterns.end());
+    std::size_t n = views.size();
+    std::unique_ptr<bool[]> found(new bool[n + 1]);
+    found[n] = true;
+
+    std::size_t hits = st.query_batch(views, std::span<bool>(found.get(), n));
+    std::size_t expected = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        CHECK(found[i] == st.is_substring(views[i]));
+        CHECK(found[i] == naive_is_substring(strings, views[i]));
+        expected += found[i];
+    }
+    CHECK(hits == expected);
+
+    // found más corto: solo los primeros `half`, el resto no se toca
+    std::size_t half = n / 2;
+    std::fill_n(found.get(), n + 1, true);
+    hits = st.query_batch(views, std::span<bool>(found.get(), half));
+    expected = 0;
+    for (std::size_t i = 0; i < half; ++i) {
+        CHECK(found[i] == st.is_substring(views[i]));
+        expected += found[i];
+    }
+    for (std::size_t i = half; i <= n; ++i) {
+        CHECK(found[i]);
+    }
+    CHECK(hits == expected);
+}
+
+static void test_against_is_substring(std::mt19937& rng) {
+    for (int iter = 0; iter < 300; ++iter) {
+        int sigma = 1 + static_cast<int>(rng() % 4);
+        SuffixTree st;
+        std::vector<std::string> strings;
+        for (int i = 0, n = 1 + static_cast<int>(rng() % 6); i < n; ++i) {
+            strings.push_back(random_string(rng, 1 + rng() % 30, sigma));
+            st.add_string(strings.back());
+        }
+        if (iter % 4 == 0 and strings.size() > 1) {
+            int id = 1 + static_cast<int>(rng() % strings.size());
+            CHECK(st.remove_string(id));
+            strings[id - 1].clear();
+        }
+        check_batch(st, strings, make_patterns(strings, rng, sigma));
+    }
+}
+
+static void test_open_stream() {
+    SuffixTree st;
+    st.add_string("abcab");
+    CHECK(st.begin_string() == SuffixTree::AddStatus::Ok);
+    CHECK(st.append("bca") == SuffixTree::AddStatus::Ok);
+
+    std::vector<std::string_view> views{"ab", "", "bca", "zz"};
+    bool found[4] = {true, true, true, true};
+    CHECK(st.query_batch(views, found) == 0);
+    for (bool f : found) {
+        CHECK(!f);
+    }
+
+    CHECK(st.finish_string().status == SuffixTree::AddStatus::Ok);
+    CHECK(st.query_batch(views, found) == 3);
+    CHECK(found[0] and found[1] and found[2] and !found[3]);
+}
+
+int main() {
+    std::mt19937 rng(13);
+    test_against_is_substring(rng);
+    test_open_stream();
+    return report("test_query_batch");
+}
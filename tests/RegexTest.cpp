@@ -0,0 +1,213 @@
+#include "SuffixTree.h"
+#include "TestUtil.h"
+#include <algorithm>
+#include <array>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * Tests de find_regex (y RegexNfa).
+ *
+ *  - Expresiones al azar (clases, comodines, escapes y cuantificadores)
+ *    coinciden con un matcher por fuerza bruta sobre los strings vivos:
+ *    cada inicio una vez, con su match más corto.
+ *  - Se rechazan (resultado vacío) las de más de MAX_POSITIONS posiciones,
+ *    las que reconocen el string vacío, las mal formadas y un max_gap
+ *    negativo.
+ *  - Vacío con un string abierto.
+ */
+
+using aed::structure::RegexNfa;
+using aed::structure::SubstringRef;
+using aed::structure::SuffixTree;
+using namespace aed::test;
+
+// Un elemento de la expresión: caracteres que acepta y repeticiones
+struct Element {
+    std::array<bool, 256> accepted;
+    int min, max;
+};
+
+// Match más corto de la secuencia que empieza en cada posición
+static std::vector<SubstringRef> naive_regex(const std::vector<std::string>& strings,
+                                             const std::vector<Element>& elements) {
+    std::vector<SubstringRef> result;
+    for (std::size_t d = 0; d < strings.size(); ++d) {
+        const std::string& s = strings[d];
+        for (std::size_t off = 0; off < s.size(); ++off) {
+            std::set<std::size_t> ends{off};
+            for (const Element& e : elements) {
+                std::set<std::size_t> next;
+                for (std::size_t p : ends) {
+                    for (int r = 0; r <= e.max and p + r <= s.size(); ++r) {
+                        if (r >= e.min) {
+                            next.insert(p + r);
+                        }
+                        if (p + r == s.size() or !e.accepted[static_cast<unsigned char>(s[p + r])]) {
+                            break;
+                        }
+                    }
+                }
+                ends = std::move(next);
+            }
+            if (!ends.empty()) {
+                result.push_back({static_cast<int>(d) + 1, static_cast<int>(off),
+                                  static_cast<int>(*ends.begin() - off)});
+            }
+        }
+    }
+    return result;
+}
+
+// Expresión al azar y sus elementos; valid indica si compile debería aceptarla
+static std::string random_regex(std::mt19937& rng, int sigma, int max_gap,
+                                std::vector<Element>& elements, bool& valid) {
+    std::string regex;
+    elements.clear();
+    int positions = 0;
+    bool some_required = false;
+    bool ordered = true;    // `+` con max_gap 0 no tiene repeticiones válidas
+    for (int i = 0, n = 1 + static_cast<int>(rng() % 5); i < n; ++i) {
+        Element e{{}, 1, 1};
+        char a = "abcd"[rng() % sigma];
+        char b = "abcd"[rng() % sigma];
+        switch (rng() % 7) {
+        case 0:
+            regex += rng() % 2 ? '.' : '?';
+            e.accepted.fill(true);
+            break;
+        case 1:
+            regex += std::string("[") + a + b + "]";
+            e.accepted[a] = e.accepted[b] = true;
+            break;
+        case 2:
+            regex += std::string("[") + std::min(a, b) + "-" + std::max(a, b) + "]";
+            for (char x = std::min(a, b); x <= std::max(a, b); ++x) {
+                e.accepted[x] = true;
+            }
+            break;
+        case 3:
+            regex += std::string("[^") + a + "]";
+            e.accepted.fill(true);
+            e.accepted[a] = false;
+            break;
+        case 4:
+            // Escape de un especial: nunca aparece en los strings
+            regex += std::string("\\") + ".?[]*+{}\\"[rng() % 9];
+            e.accepted[static_cast<unsigned char>(regex.back())] = true;
+            break;
+        default:
+            regex += a;
+            e.accepted[a] = true;
+        }
+        switch (rng() % 6) {
+        case 0:
+            regex += '*';
+            e = {e.accepted, 0, max_gap};
+            break;
+        case 1:
+            regex += '+';
+            e = {e.accepted, 1, max_gap};
+            break;
+        case 2:
+            e.min = e.max = static_cast<int>(rng() % 4);
+            regex += "{" + std::to_string(e.min) + "}";
+            break;
+        case 3:
+            e.min = static_cast<int>(rng() % 3);
+            e.max = e.min + static_cast<int>(rng() % 4);
+            regex += "{" + std::to_string(e.min) + "," + std::to_string(e.max) + "}";
+            break;
+        default:
+            break;
+        }
+        positions += e.max;
+        some_required = some_required or e.min > 0;
+        ordered = ordered and e.max >= e.min;
+        elements.push_back(e);
+    }
+    valid = some_required and ordered and positions <= RegexNfa::MAX_POSITIONS;
+    return regex;
+}
+
+static void test_against_naive(std::mt19937& rng) {
+    for (int iter = 0; iter < 300; ++iter) {
+        int sigma = 1 + static_cast<int>(rng() % 4);
+        SuffixTree st;
+        std::vector<std::string> strings;
+        for (int op = 0, n = 1 + static_cast<int>(rng() % 8); op < n; ++op) {
+            int id = 1 + static_cast<int>(rng() % (strings.size() + 1));
+            if (rng() % 4 == 0 and id <= static_cast<int>(strings.size())) {
+                CHECK(st.remove_string(id) == !strings[id - 1].empty());
+                strings[id - 1].clear();
+            } else {
+                std::string s = random_string(rng, 1 + rng() % 25, sigma);
+                CHECK(st.add_string(s) == static_cast<int>(strings.size()) + 1);
+                strings.push_back(s);
+            }
+            for (int q = 0; q < 5; ++q) {
+                int max_gap = static_cast<int>(rng() % 6);
+                std::vector<Element> elements;
+                bool valid;
+                std::string regex = random_regex(rng, sigma, max_gap, elements, valid);
+                RegexNfa nfa;
+                CHECK(nfa.compile(regex, max_gap) == valid);
+                std::vector<SubstringRef> expected = valid ? naive_regex(strings, elements)
+                                                           : std::vector<SubstringRef>{};
+                CHECK(st.find_regex(regex, max_gap) == expected);
+            }
+        }
+    }
+}
+
+static void test_rejected() {
+    SuffixTree st;
+    st.add_string(std::string(70, 'a') + "b");
+    st.add_string("abcab");
+
+    // MAX_POSITIONS justas se aceptan, una más no
+    CHECK(st.find_regex("a{63}").size() == 8);
+    CHECK(st.find_regex("a{32}a{31}").size() == 8);
+    CHECK(st.find_regex("a{64}").empty());
+    CHECK(st.find_regex("a{32}a{32}").empty());
+    CHECK(st.find_regex("a{60}b*", 4).empty());
+    CHECK(st.find_regex("a{60}b+", 3).size() == 1);
+    CHECK(st.find_regex("a{1000}").empty());
+
+    // Reconocen el string vacío
+    for (const char* regex : {"a*", "a{0}", "a{0,3}", "a*b*", "[ab]{0,2}c*", ""}) {
+        CHECK(st.find_regex(regex).empty());
+    }
+
+    // max_gap inválido, con y sin * o +
+    CHECK(!st.find_regex("ab*").empty());
+    CHECK(st.find_regex("ab*", -1).empty());
+    CHECK(st.find_regex("ab", -1).empty());
+    CHECK(st.find_regex("a+", -5).empty());
+
+    // Mal formadas
+    for (const char* regex : {"[ab", "a{2", "a{3,1}", "a{,2}", "\\", "*a", "+a", "]", "a{2}}", "[c-a]", "{2}"}) {
+        CHECK(st.find_regex(regex).empty());
+    }
+}
+
+static void test_open_stream() {
+    SuffixTree st;
+    st.add_string("abcab");
+    CHECK(st.begin_string() == SuffixTree::AddStatus::Ok);
+    CHECK(st.append("cab") == SuffixTree::AddStatus::Ok);
+    CHECK(st.find_regex("ab").empty());
+    CHECK(st.finish_string().id == 2);
+    std::vector<SubstringRef> expected{{1, 0, 2}, {1, 3, 2}, {2, 1, 2}};
+    CHECK(st.find_regex("ab") == expected);
+}
+
+int main() {
+    std::mt19937 rng(25);
+    test_against_naive(rng);
+    test_rejected();
+    test_open_stream();
+    return report("test_regex");
+}
@@ -0,0 +1,178 @@
+#include "SuffixTree.h"
+#include "MappedSuffixTree.h"
+#include "TestUtil.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Tests de remove_string, la compactación del texto y save/MappedSuffixTree.
+ *
+ *  - Altas y bajas al azar: después de cada una, find_all, count,
+ *    document_frequency, is_suffix y get_string coinciden con fuerza bruta
+ *    sobre los strings vivos, y la arena no guarda nodos quitados.
+ *  - save + open: el archivo (con strings quitados) responde igual que el
+ *    árbol; un byte cambiado da BadChecksum, y sin checksum un archivo
+ *    corrupto da Ok o BadLayout con verify_indices, nunca lecturas fuera
+ *    del mapeo.
+ *  - freeze compacta y save sobre un árbol congelado no lo modifica.
+ */
+
+using aed::structure::MappedSuffixTree;
+using aed::structure::SuffixTree;
+using LoadStatus = MappedSuffixTree::LoadStatus;
+using namespace aed::test;
+
+static const char* FILE_NAME = "remove_test.bin";
+
+// is_suffix por fuerza bruta (strings quitados vacíos)
+static bool naive_is_suffix(const std::vector<std::string>& strings, const std::string& p) {
+    for (const auto& s : strings) {
+        if (!s.empty() and s.size() >= p.size() and s.compare(s.size() - p.size(), p.size(), p) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void check_tree(SuffixTree& st, const std::vector<std::string>& strings, std::mt19937& rng, int sigma) {
+    CHECK(st.get_string_count() == static_cast<int>(strings.size()));
+    for (std::size_t i = 0; i < strings.size(); ++i) {
+        CHECK(st.get_string(static_cast<int>(i) + 1) == strings[i]);
+    }
+    CHECK(st.tree.arena.size() == reachable_nodes(st));
+
+    st.compute_counts();
+    for (int q = 0; q < 20; ++q) {
+        std::string p = random_string(rng, 1 + rng() % 4, sigma);
+        Hits expected = naive_find_all(strings, p);
+        CHECK(sorted_hits(st.find_all(p)) == expected);
+        CHECK(st.count(p) == static_cast<int>(expected.size()));
+        CHECK(st.document_frequency(p) == distinct_strings(expected));
+        CHECK(st.is_suffix(p) == naive_is_suffix(strings, p));
+    }
+}
+
+static void check_mapped(const SuffixTree& st, const MappedSuffixTree& mt, std::mt19937& rng, int sigma) {
+    CHECK(mt.get_string_count() == st.get_string_count());
+    for (int id = 1; id <= st.get_string_count(); ++id) {
+        CHECK(mt.get_string(id) == st.get_string(id));
+    }
+    for (int q = 0; q < 20; ++q) {
+        std::string p = random_string(rng, 1 + rng() % 4, sigma);
+        CHECK(sorted_hits(mt.find_all(p)) == sorted_hits(st.find_all(p)));
+        CHECK(mt.count(p) == st.count(p));
+        CHECK(mt.document_frequency(p) == st.document_frequency(p));
+        CHECK(mt.is_suffix(p) == st.is_suffix(p));
+        CHECK(mt.is_substring(p) == st.is_substring(p));
+    }
+}
+
+static std::string read_file(const char* path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), {});
+}
+
+static void write_file(const char* path, const std::string& bytes) {
+    std::ofstream out(path, std::ios::binary);
+    out << bytes;
+}
+
+// Cambia algunas palabras de 4 bytes después del header y abre sin checksum
+// pero verificando índices
+static void check_corrupt(const std::string& image, std::mt19937& rng, int sigma) {
+    std::size_t body = sizeof(aed::structure::flat::Header);
+    for (int c = 0; c < 20; ++c) {
+        std::string bytes = image;
+        for (int f = 0, n = 1 + static_cast<int>(rng() % 3); f < n; ++f) {
+            std::size_t pos = (body + rng() % (bytes.size() - body)) & ~std::size_t{3};
+            std::int32_t values[] = {-1, 0, static_cast<std::int32_t>(rng() % 64), static_cast<std::int32_t>(rng())};
+            std::memcpy(&bytes[pos], &values[rng() % 4], sizeof(std::int32_t));
+        }
+        write_file(FILE_NAME, bytes);
+
+        MappedSuffixTree mt;
+        LoadStatus status = mt.open(FILE_NAME, false, true);
+        CHECK(status == LoadStatus::Ok or status == LoadStatus::BadLayout);
+        if (status == LoadStatus::Ok) {
+            for (int q = 0; q < 10; ++q) {
+                std::string p = random_string(rng, rng() % 6, sigma);
+                mt.find_all(p);
+                mt.documents(p);
+                mt.is_suffix(p);
+            }
+            for (int id = 0; id <= mt.get_string_count() + 1; ++id) {
+                mt.get_string(id);
+            }
+        }
+    }
+}
+
+static void test_remove_and_save(std::mt19937& rng) {
+    for (int iter = 0; iter < 200; ++iter) {
+        int sigma = 1 + static_cast<int>(rng() % 4);
+        SuffixTree st;
+        std::vector<std::string> strings;
+        for (int op = 0, n = 1 + static_cast<int>(rng() % 25); op < n; ++op) {
+            int id = 1 + static_cast<int>(rng() % (strings.size() + 1));
+            if (rng() % 3 == 0 and id <= static_cast<int>(strings.size())) {
+                CHECK(st.remove_string(id) == !strings[id - 1].empty());
+                strings[id - 1].clear();
+            } else {
+                std::string s = random_string(rng, 1 + rng() % 12, sigma);
+                CHECK(st.add_string(s) == static_cast<int>(strings.size()) + 1);
+                strings.push_back(s);
+            }
+            check_tree(st, strings, rng, sigma);
+        }
+
+        CHECK(st.save(FILE_NAME));
+        MappedSuffixTree mt;
+        CHECK(mt.open(FILE_NAME) == LoadStatus::Ok);
+        check_mapped(st, mt, rng, sigma);
+        mt.close();
+
+        std::string image = read_file(FILE_NAME);
+        if (iter % 10 == 0) {
+            std::string bytes = image;
+            bytes[bytes.size() / 2] ^= 0x5a;
+            write_file(FILE_NAME, bytes);
+            CHECK(mt.open(FILE_NAME) == LoadStatus::BadChecksum);
+        }
+        check_corrupt(image, rng, sigma);
+    }
+    std::remove(FILE_NAME);
+}
+
+static void test_save_frozen() {
+    SuffixTree st;
+    st.add_string("abcabcabcabcabcabc");
+    st.add_string("ab");
+    st.add_string("bcab");
+    CHECK(st.remove_string(2));  // poco texto muerto: remove_string no compacta
+
+    CHECK(st.freeze());
+    std::string_view view = st.get_string(3);
+    std::string before = st.text;
+    CHECK(st.save(FILE_NAME));
+    CHECK(st.text == before);
+    CHECK(st.get_string(3).data() == view.data());
+    CHECK(st.get_string(2).empty());
+
+    MappedSuffixTree mt;
+    CHECK(mt.open(FILE_NAME) == LoadStatus::Ok);
+    CHECK(mt.get_string(3) == "bcab");
+    CHECK(mt.count("bcab") == 6);
+    std::remove(FILE_NAME);
+}
+
+int main() {
+    std::mt19937 rng(19);
+    test_remove_and_save(rng);
+    test_save_frozen();
+    return report("test_remove_string");
+}
@@ -0,0 +1,143 @@
+#include "SuffixTree.h"
+#include "TestUtil.h"
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Tests de maximal_repeats y supermaximal_repeats.
+ *
+ *  - Los pares (largo, apariciones) reportados coinciden con fuerza bruta
+ *    sobre todos los substrings de los strings vivos: diversidad a la
+ *    izquierda y a la derecha (inicio y fin de string cuentan como
+ *    contextos únicos), supermaximalidad y el filtro min_length.
+ *  - Con un string abierto no reporta nada.
+ */
+
+using aed::structure::Occurrence;
+using aed::structure::SuffixTree;
+using namespace aed::test;
+using Index = SuffixTree::Index;
+
+using Repeats = std::vector<std::pair<int, Hits>>;
+
+// Repeticiones por fuerza bruta. Un string quitado se representa vacío
+static Repeats naive_repeats(const std::vector<std::string>& strings, bool supermaximal, int min_length) {
+    std::set<std::string> subs;
+    for (const auto& s : strings) {
+        for (std::size_t i = 0; i < s.size(); ++i) {
+            for (std::size_t len = std::max<std::size_t>(min_length, 1); i + len <= s.size(); ++len) {
+                subs.insert(s.substr(i, len));
+            }
+        }
+    }
+
+    Repeats result;
+    for (const std::string& w : subs) {
+        Hits hits = naive_find_all(strings, w);
+        if (hits.size() < 2) {
+            continue;
+        }
+        // Contextos de cada aparición: -1 en el inicio o el fin del string
+        std::vector<int> left, right;
+        for (auto [id, off] : hits) {
+            const std::string& s = strings[id - 1];
+            left.push_back(off == 0 ? -1 : static_cast<unsigned char>(s[off - 1]));
+            right.push_back(off + w.size() == s.size() ? -1 : static_cast<unsigned char>(s[off + w.size()]));
+        }
+
+        bool keep;
+        if (supermaximal) {
+            // Ninguna extensión de un carácter se repite
+            keep = true;
+            for (const auto* ctx : {&left, &right}) {
+                std::vector<int> chars;
+                std::copy_if(ctx->begin(), ctx->end(), std::back_inserter(chars), [](int c) { return c >= 0; });
+                std::sort(chars.begin(), chars.end());
+                keep = keep and std::adjacent_find(chars.begin(), chars.end()) == chars.end();
+            }
+        } else {
+            auto diverse = [](const std::vector<int>& ctx) {
+                return std::count(ctx.begin(), ctx.end(), -1) > 0
+                    or std::count(ctx.begin(), ctx.end(), ctx[0]) != static_cast<long>(ctx.size());
+            };
+            keep = diverse(left) and diverse(right);
+        }
+        if (keep) {
+            result.push_back({static_cast<int>(w.size()), hits});
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+static Repeats collect(const SuffixTree& st, bool supermaximal, Index min_length) {
+    Repeats result;
+    auto report = [&](Index length, std::span<const Occurrence> occs) {
+        result.push_back({length, sorted_hits({occs.begin(), occs.end()})});
+    };
+    if (supermaximal) {
+        st.supermaximal_repeats(report, min_length);
+    } else {
+        st.maximal_repeats(report, min_length);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+static void check_repeats(const SuffixTree& st, const std::vector<std::string>& strings, int min_length) {
+    Repeats maximal = collect(st, false, min_length);
+    Repeats super = collect(st, true, min_length);
+    CHECK(maximal == naive_repeats(strings, false, min_length));
+    CHECK(super == naive_repeats(strings, true, min_length));
+    CHECK(std::includes(maximal.begin(), maximal.end(), super.begin(), super.end()));
+}
+
+static void test_against_naive(std::mt19937& rng) {
+    for (int iter = 0; iter < 300; ++iter) {
+        int sigma = 1 + static_cast<int>(rng() % 4);
+        SuffixTree st;
+        std::vector<std::string> strings;
+        for (int op = 0, n = 1 + static_cast<int>(rng() % 8); op < n; ++op) {
+            int id = 1 + static_cast<int>(rng() % (strings.size() + 1));
+            if (rng() % 4 == 0 and id <= static_cast<int>(strings.size())) {
+                CHECK(st.remove_string(id) == !strings[id - 1].empty());
+                strings[id - 1].clear();
+            } else {
+                // A veces un sufijo de otro string, para tener hojas compartidas
+                std::string s = random_string(rng, 1 + rng() % 15, sigma);
+                if (rng() % 4 == 0 and !strings.empty() and !strings.back().empty()) {
+                    s += strings.back().substr(rng() % strings.back().size());
+                }
+                CHECK(st.add_string(s) == static_cast<int>(strings.size()) + 1);
+                strings.push_back(s);
+            }
+            check_repeats(st, strings, 1);
+            check_repeats(st, strings, 1 + static_cast<int>(rng() % 5));
+        }
+    }
+}
+
+static void test_open_stream() {
+    SuffixTree st;
+    st.add_string("abcabc");
+    CHECK(st.begin_string() == SuffixTree::AddStatus::Ok);
+    CHECK(st.append("abc") == SuffixTree::AddStatus::Ok);
+    CHECK(collect(st, false, 1).empty());
+    CHECK(collect(st, true, 1).empty());
+    CHECK(st.finish_string().id == 2);
+    check_repeats(st, {"abcabc", "abc"}, 1);
+    check_repeats(st, {"abcabc", "abc"}, 3);
+}
+
+int main() {
+    std::mt19937 rng(23);
+    test_against_naive(rng);
+    test_open_stream();
+    return report("test_repeats");
+}
@@ -0,0 +1,331 @@
+#include "SuffixTree.h"
+#include "MappedSuffixTree.h"
+#include "TestUtil.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Tests de save y MappedSuffixTree.
+ *
+ *  - Árboles al azar (con strings quitados, o armados con
+ *    add_strings_parallel) guardados y abiertos responden is_substring,
+ *    is_suffix, find_all, count, document_frequency y documents igual que
+ *    el árbol original. COLORS guarda un color por sufijo (solo hojas).
+ *  - Header corrupto: BadMagic, BadVersion o BadLayout según el campo;
+ *    archivo truncado, agrandado o vacío.
+ *  - Un byte cambiado en cualquier sección, o en el checksum, da
+ *    BadChecksum; sin verificar el checksum abre igual.
+ *  - Índices fuera de rango con el checksum recalculado: open los acepta
+ *    por defecto y con verify_indices da BadLayout.
+ */
+
+using aed::structure::MappedSuffixTree;
+using aed::structure::SuffixTree;
+using LoadStatus = MappedSuffixTree::LoadStatus;
+using namespace aed::test;
+namespace flat = aed::structure::flat;
+
+static const char* FILE_NAME = "serialize_test.bin";
+
+static std::string read_file(const char* path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), {});
+}
+
+static void write_file(const char* path, const std::string& bytes) {
+    std::ofstream out(path, std::ios::binary);
+    out << bytes;
+}
+
+static LoadStatus open_bytes(const std::string& bytes, bool verify_checksum = true, bool verify_indices = false) {
+    write_file(FILE_NAME, bytes);
+    MappedSuffixTree mt;
+    return mt.open(FILE_NAME, verify_checksum, verify_indices);
+}
+
+static flat::Header header_of(const std::string& bytes) {
+    flat::Header h;
+    std::memcpy(&h, bytes.data(), sizeof(h));
+    return h;
+}
+
+static void set_header(std::string& bytes, const flat::Header& h) {
+    std::memcpy(&bytes[0], &h, sizeof(h));
+}
+
+// Campo de 4 bytes del elemento i de una sección
+static std::size_t field_pos(const std::string& bytes, flat::SectionId s, std::size_t element_size,
+                             std::size_t i, std::size_t field) {
+    return header_of(bytes).sections[s].offset + i * element_size + field;
+}
+
+static std::int32_t get_i32(const std::string& bytes, std::size_t pos) {
+    std::int32_t v;
+    std::memcpy(&v, &bytes[pos], sizeof(v));
+    return v;
+}
+
+static void set_i32(std::string& bytes, std::size_t pos, std::int32_t v) {
+    std::memcpy(&bytes[pos], &v, sizeof(v));
+}
+
+// Recalcula el checksum después de modificar el cuerpo
+static void reseal(std::string& bytes) {
+    flat::Checksum sum;
+    sum.update(bytes.data() + sizeof(flat::Header), bytes.size() - sizeof(flat::Header));
+    flat::Header h = header_of(bytes);
+    h.checksum = sum.value();
+    set_header(bytes, h);
+}
+
+// Patrón al azar: del alfabeto, copiado de un string o con END_TOKEN
+static std::string random_pattern(const std::vector<std::string>& strings, std::mt19937& rng, int sigma) {
+    const std::string& s = strings[rng() % strings.size()];
+    switch (rng() % 4) {
+    case 0:
+        return random_string(rng, 1 + rng() % 4, sigma);
+    case 1:
+        return s.substr(rng() % (s.size() + 1)) + (rng() % 2 ? std::string(1, SuffixTree::END_TOKEN) : "");
+    default: {
+        std::size_t from = rng() % (s.size() + 1);
+        return s.substr(from, rng() % 8);
+    }
+    }
+}
+
+static std::vector<int> distinct_ids(const Hits& hits) {
+    std::vector<int> ids;
+    for (auto [id, off] : hits) {
+        if (ids.empty() or ids.back() != id) {
+            ids.push_back(id);
+        }
+    }
+    return ids;
+}
+
+static void check_mapped(SuffixTree& st, const std::vector<std::string>& strings, std::mt19937& rng, int sigma) {
+    CHECK(st.save(FILE_NAME));
+    std::string image = read_file(FILE_NAME);
+    MappedSuffixTree mt;
+    CHECK(mt.open(FILE_NAME, true, true) == LoadStatus::Ok);
+
+    // Un color por sufijo vivo (cada string más su END_TOKEN)
+    std::uint64_t suffixes = 0;
+    for (const auto& s : strings) {
+        suffixes += s.empty() ? 0 : s.size() + 1;
+    }
+    CHECK(header_of(image).sections[flat::COLORS].count == suffixes);
+
+    CHECK(mt.get_string_count() == st.get_string_count());
+    for (int id = 0; id <= st.get_string_count() + 1; ++id) {
+        CHECK(mt.get_string(id) == st.get_string(id));
+    }
+    for (int q = 0; q < 30; ++q) {
+        std::string p = random_pattern(strings, rng, sigma);
+        Hits hits = sorted_hits(st.find_all(p));
+        CHECK(sorted_hits(mt.find_all(p)) == hits);
+        CHECK(mt.is_substring(p) == st.is_substring(p));
+        CHECK(mt.is_suffix(p) == st.is_suffix(p));
+        CHECK(mt.count(p) == st.count(p));
+        CHECK(mt.document_frequency(p) == st.document_frequency(p));
+        CHECK(mt.documents(p) == distinct_ids(hits));
+    }
+}
+
+static void test_random_trees(std::mt19937& rng) {
+    for (int iter = 0; iter < 150; ++iter) {
+        int sigma = 1 + static_cast<int>(rng() % 4);
+        SuffixTree st;
+        std::vector<std::string> strings;
+        for (int op = 0, n = 1 + static_cast<int>(rng() % 15); op < n; ++op) {
+            int id = 1 + static_cast<int>(rng() % (strings.size() + 1));
+            if (rng() % 3 == 0 and id <= static_cast<int>(strings.size())) {
+                CHECK(st.remove_string(id) == !strings[id - 1].empty());
+                strings[id - 1].clear();
+            } else {
+                // A veces un sufijo de otro string, para tener hojas compartidas
+                std::string s = random_string(rng, 1 + rng() % 15, sigma);
+                if (rng() % 4 == 0 and !strings.empty() and !strings.back().empty()) {
+                    s += strings.back().substr(rng() % strings.back().size());
+                }
+                CHECK(st.add_string(s) == static_cast<int>(strings.size()) + 1);
+                strings.push_back(s);
+            }
+        }
+        check_mapped(st, strings, rng, sigma);
+    }
+}
+
+static void test_parallel_build(std::mt19937& rng) {
+    for (int iter = 0; iter < 20; ++iter) {
+        int sigma = 1 + static_cast<int>(rng() % 4);
+        std::vector<std::string> strings;
+        for (int i = 0; i < 10; ++i) {
+            strings.push_back(random_string(rng, 1 + rng() % 30, sigma));
+        }
+        std::vector<std::string_view> views(strings.begin(), strings.end());
+        SuffixTree st;
+        st.add_strings_parallel(views, 3);
+        check_mapped(st, strings, rng, sigma);
+    }
+}
+
+// Árbol chico con hojas compartidas y un string quitado
+static std::string sample_image() {
+    SuffixTree st;
+    st.add_string("abcabcab");
+    st.add_string("cab");
+    st.add_string("bcbc");
+    st.add_string("ab");
+    st.remove_string(3);
+    CHECK(st.save(FILE_NAME));
+    return read_file(FILE_NAME);
+}
+
+static void test_header(const std::string& image) {
+    CHECK(open_bytes(image) == LoadStatus::Ok);
+    const flat::Header h = header_of(image);
+
+    auto with = [&](auto edit) {
+        flat::Header copy = h;
+        edit(copy);
+        std::string bytes = image;
+        set_header(bytes, copy);
+        return open_bytes(bytes);
+    };
+    CHECK(with([](flat::Header& x) { x.magic[0] = 'X'; }) == LoadStatus::BadMagic);
+    CHECK(with([](flat::Header& x) { ++x.version; }) == LoadStatus::BadVersion);
+    CHECK(with([](flat::Header& x) { x.endian_tag = 0x04030201; }) == LoadStatus::BadVersion);
+    CHECK(with([](flat::Header& x) { x.header_size += 8; }) == LoadStatus::BadLayout);
+    CHECK(with([](flat::Header& x) { x.node_size += 4; }) == LoadStatus::BadLayout);
+    CHECK(with([](flat::Header& x) { x.edge_size = 0; }) == LoadStatus::BadLayout);
+    CHECK(with([](flat::Header& x) { x.file_size += 8; }) == LoadStatus::BadLayout);
+    CHECK(with([](flat::Header& x) { ++x.string_count; }) == LoadStatus::BadLayout);
+    CHECK(with([](flat::Header& x) { x.sections[flat::NODES].count = 0; }) == LoadStatus::BadLayout);
+    for (int s = 0; s < flat::SECTION_COUNT; ++s) {
+        CHECK(with([s](flat::Header& x) { x.sections[s].offset += 4; }) == LoadStatus::BadLayout);
+        CHECK(with([s](flat::Header& x) { x.sections[s].offset = 0; }) == LoadStatus::BadLayout);
+        CHECK(with([&](flat::Header& x) { x.sections[s].offset = flat::align8(image.size() + 8); }) == LoadStatus::BadLayout);
+        CHECK(with([&](flat::Header& x) { x.sections[s].count = image.size(); }) == LoadStatus::BadLayout);
+        CHECK(with([s](flat::Header& x) { x.sections[s].count = ~std::uint64_t{0}; }) == LoadStatus::BadLayout);
+    }
+
+    // El checksum del header no coincide: solo se nota si se verifica
+    CHECK(with([](flat::Header& x) { x.checksum ^= 1; }) == LoadStatus::BadChecksum);
+    std::string bytes = image;
+    flat::Header copy = h;
+    copy.checksum ^= 1;
+    set_header(bytes, copy);
+    CHECK(open_bytes(bytes, false) == LoadStatus::Ok);
+    CHECK(open_bytes(bytes, false, true) == LoadStatus::Ok);
+
+    // Tamaño del archivo
+    CHECK(open_bytes(image.substr(0, image.size() - 8)) == LoadStatus::BadLayout);
+    CHECK(open_bytes(image + std::string(8, '\0')) == LoadStatus::BadLayout);
+    CHECK(open_bytes(image.substr(0, sizeof(flat::Header) - 1)) == LoadStatus::BadMagic);
+    CHECK(open_bytes("") == LoadStatus::OpenFailed);
+    std::remove(FILE_NAME);
+    MappedSuffixTree mt;
+    CHECK(mt.open(FILE_NAME) == LoadStatus::OpenFailed);
+    CHECK(!mt.is_open());
+}
+
+static void test_sections(const std::string& image, std::mt19937& rng) {
+    const flat::Header h = header_of(image);
+    const std::size_t element_size[flat::SECTION_COUNT] = {
+        sizeof(char), sizeof(std::int32_t), sizeof(flat::Node),
+        sizeof(flat::Edge), sizeof(flat::Shared), sizeof(std::int32_t)
+    };
+    for (int s = 0; s < flat::SECTION_COUNT; ++s) {
+        std::size_t bytes_in_section = h.sections[s].count * element_size[s];
+        CHECK(bytes_in_section > 0);
+        for (int c = 0; c < 5 and bytes_in_section > 0; ++c) {
+            std::string bytes = image;
+            bytes[h.sections[s].offset + rng() % bytes_in_section] ^= static_cast<char>(1 + rng() % 255);
+            CHECK(open_bytes(bytes) == LoadStatus::BadChecksum);
+            LoadStatus unchecked = open_bytes(bytes, false, true);
+            CHECK(unchecked == LoadStatus::Ok or unchecked == LoadStatus::BadLayout);
+        }
+    }
+}
+
+// Índices fuera de rango con el checksum recalculado (ver validate_indices)
+static void test_indices(const std::string& image) {
+    const flat::Header h = header_of(image);
+    const std::int32_t node_count = static_cast<std::int32_t>(h.sections[flat::NODES].count);
+    const std::int32_t edge_count = static_cast<std::int32_t>(h.sections[flat::EDGES].count);
+    const std::int32_t shared_count = static_cast<std::int32_t>(h.sections[flat::SHARED].count);
+    const std::int32_t text_size = static_cast<std::int32_t>(h.sections[flat::TEXT].count);
+    const std::int32_t strings = static_cast<std::int32_t>(h.string_count);
+
+    auto node = [&](std::size_t i, std::size_t field) {
+        return field_pos(image, flat::NODES, sizeof(flat::Node), i, field);
+    };
+    // Primera hoja con sufijos compartidos
+    std::int32_t leaf = -1;
+    for (std::int32_t i = 0; i < node_count and leaf < 0; ++i) {
+        if (get_i32(image, node(i, offsetof(flat::Node, shared))) >= 0) {
+            leaf = i;
+        }
+    }
+    CHECK(leaf > 0);
+    std::int32_t first_shared = get_i32(image, node(leaf, offsetof(flat::Node, shared)));
+
+    struct Corruption {
+        std::size_t pos;
+        std::int32_t value;
+    };
+    std::vector<Corruption> corruptions = {
+        {node(0, offsetof(flat::Node, first_edge)), edge_count},
+        {node(0, offsetof(flat::Node, first_edge)), -1},
+        {node(0, offsetof(flat::Node, edge_count)), edge_count + 1},
+        {node(0, offsetof(flat::Node, subtree_end)), node_count + 1},
+        {node(1, offsetof(flat::Node, subtree_end)), 1},
+        {node(0, offsetof(flat::Node, documents)), strings + 1},
+        {node(leaf, offsetof(flat::Node, color_begin)), static_cast<std::int32_t>(h.sections[flat::COLORS].count)},
+        {node(leaf, offsetof(flat::Node, color_count)), -1},
+        {node(leaf, offsetof(flat::Node, suffix_start)), -1},
+        {node(leaf, offsetof(flat::Node, suffix_start)), text_size},
+        {node(leaf, offsetof(flat::Node, string_id)), strings + 1},
+        {node(leaf, offsetof(flat::Node, shared)), shared_count},
+        {field_pos(image, flat::SHARED, sizeof(flat::Shared), first_shared, offsetof(flat::Shared, next)), first_shared},
+        {field_pos(image, flat::SHARED, sizeof(flat::Shared), first_shared, offsetof(flat::Shared, string_id)), 0},
+        {field_pos(image, flat::EDGES, sizeof(flat::Edge), 0, offsetof(flat::Edge, target)), node_count},
+        {field_pos(image, flat::EDGES, sizeof(flat::Edge), 0, offsetof(flat::Edge, target)), 0},
+        {field_pos(image, flat::EDGES, sizeof(flat::Edge), 0, offsetof(flat::Edge, label)), text_size},
+        {field_pos(image, flat::EDGES, sizeof(flat::Edge), 0, offsetof(flat::Edge, label)), -1},
+        {field_pos(image, flat::STRING_OFFSETS, sizeof(std::int32_t), 0, 0), 1},
+        {field_pos(image, flat::STRING_OFFSETS, sizeof(std::int32_t), 1, 0), text_size + 1},
+        {field_pos(image, flat::COLORS, sizeof(std::int32_t), 0, 0), strings},
+        {field_pos(image, flat::COLORS, sizeof(std::int32_t), 0, 0), -1},
+    };
+    for (const Corruption& c : corruptions) {
+        std::string bytes = image;
+        CHECK(get_i32(bytes, c.pos) != c.value);
+        set_i32(bytes, c.pos, c.value);
+        reseal(bytes);
+        CHECK(open_bytes(bytes) == LoadStatus::Ok);
+        CHECK(open_bytes(bytes, true, true) == LoadStatus::BadLayout);
+        CHECK(open_bytes(bytes, false, true) == LoadStatus::BadLayout);
+    }
+}
+
+int main() {
+    std::mt19937 rng(16);
+    test_random_trees(rng);
+    test_parallel_build(rng);
+    std::string image = sample_image();
+    test_header(image);
+    test_sections(image, rng);
+    test_indices(image);
+    std::remove(FILE_NAME);
+    return report("test_serialize");
+}
@@ -0,0 +1,82 @@
+#include "SlidingWindowSuffixTree.h"
+#include "TestUtil.h"
+#include <random>
+#include <string>
+
+/**
+ * Tests de SlidingWindowSuffixTree contra fuerza bruta sobre la ventana.
+ *
+ * Después de cada carácter verifica que contents() sea la ventana, que
+ * is_substring y find respondan igual que std::string::find sobre ella
+ * (find con una posición absoluta del flujo dentro de la ventana) y que
+ * los nodos no pasen de window + 1. Una corrida larga con el alfabeto
+ * cambiando por tramos ejercita el borrado de hojas viejas.
+ */
+
+using aed::structure::SlidingWindowSuffixTree;
+using Position = SlidingWindowSuffixTree::Position;
+using namespace aed::test;
+
+// Compara las consultas con la ventana; all es el flujo completo
+static void check_queries(const SlidingWindowSuffixTree& st, const std::string& all, std::mt19937& rng, int sigma) {
+    std::string win = st.contents();
+    std::size_t w = st.window();
+    CHECK(win == (all.size() > w ? all.substr(all.size() - w) : all));
+    CHECK(st.end_position() == static_cast<Position>(all.size()));
+    CHECK(st.begin_position() == st.end_position() - static_cast<Position>(win.size()));
+
+    for (int q = 0; q < 10; ++q) {
+        std::string p;
+        if (rng() % 2 == 0 and !win.empty()) {
+            std::size_t a = rng() % win.size();
+            p = win.substr(a, rng() % (win.size() - a + 1));
+        } else {
+            p = random_string(rng, rng() % 8, sigma);
+        }
+        bool expected = win.find(p) != std::string::npos;
+        Position at = st.find(p);
+        CHECK(st.is_substring(p) == expected);
+        CHECK((at >= 0) == expected);
+        if (at >= 0) {
+            CHECK(at >= st.begin_position() and at + static_cast<Position>(p.size()) <= st.end_position());
+            CHECK(all.compare(static_cast<std::size_t>(at), p.size(), p) == 0);
+        }
+    }
+}
+
+int main() {
+    std::mt19937 rng(18);
+    for (int iter = 0; iter < 1000; ++iter) {
+        std::size_t window = 1 + rng() % 40;
+        int sigma = 1 + static_cast<int>(rng() % 4);
+        SlidingWindowSuffixTree st(window);
+        std::string all;
+        for (std::size_t i = 0, n = rng() % 300; i < n; ++i) {
+            if (rng() % 4 == 0) {
+                std::string chunk = random_string(rng, rng() % 10, sigma);
+                st.append(chunk);
+                all += chunk;
+            } else {
+                char c = "abcd"[rng() % sigma];
+                st.push(c);
+                all.push_back(c);
+            }
+            check_queries(st, all, rng, sigma);
+        }
+        CHECK(st.node_count() <= window + 1);
+    }
+
+    SlidingWindowSuffixTree st(1000);
+    std::string all;
+    for (int i = 0; i < 200000; ++i) {
+        int sigma = 1 + (i / 20000) % 4;
+        char c = (i / 5000) % 3 == 0 ? "ab"[i % 7 == 0] : "abcd"[rng() % sigma];
+        st.push(c);
+        all.push_back(c);
+        if (i % 997 == 0) {
+            check_queries(st, all, rng, 4);
+        }
+    }
+    CHECK(st.node_count() <= 1001);
+    return report("test_sliding_window");
+}
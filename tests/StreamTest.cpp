@@ -0,0 +1,189 @@
+#include "SuffixTree.h"
+#include "TestUtil.h"
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+#ifndef _WIN32
+#include <csignal>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Tests de la construcción incremental (begin_string/append/finish_string
+ * y add_file).
+ *
+ *  - append en bloques de distinto tamaño da el mismo árbol que add_string.
+ *  - add_file desde un archivo regular y desde un FIFO (que no se puede
+ *    posicionar) agrega el contenido completo.
+ *  - Un add_file que falla (END_TOKEN después de varios bloques ya
+ *    extendidos, archivo inexistente o que no se puede leer) no deja
+ *    rastro: mismo text, mismo próximo ID, colores y conteos al día,
+ *    ningún nodo de más en la arena y las mismas respuestas que un árbol
+ *    que nunca lo intentó, también al seguir agregando strings.
+ */
+
+using aed::structure::SuffixTree;
+using namespace aed::test;
+
+static const char* PATTERNS[] = {"a", "ab", "ba", "abc", "cab", "bca", "aaa", "dd", "abcd$"};
+
+// Mismas respuestas que ref para PATTERNS (ambos con compute_counts hecho)
+static bool same_answers(const SuffixTree& a, const SuffixTree& ref) {
+    for (const char* p : PATTERNS) {
+        if (a.count(p) != ref.count(p) or a.document_frequency(p) != ref.document_frequency(p) or
+            a.is_suffix(p) != ref.is_suffix(p) or a.find_all(p).size() != ref.find_all(p).size()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void write_file(const std::string& path, const std::string& content) {
+    std::ofstream out(path, std::ios::binary);
+    out << content;
+}
+
+static void test_append_chunks(std::mt19937& rng) {
+    for (int iter = 0; iter < 100; ++iter) {
+        SuffixTree st, ref;
+        int k = 1 + static_cast<int>(rng() % 5);
+        for (int i = 0; i < k; ++i) {
+            std::string s = random_string(rng, 1 + rng() % 40, 1 + static_cast<int>(rng() % 4));
+            ref.add_string(s);
+
+            CHECK(st.begin_string() == SuffixTree::AddStatus::Ok);
+            for (std::size_t pos = 0; pos < s.size();) {
+                std::size_t len = 1 + rng() % 7;
+                CHECK(st.append(std::string_view(s).substr(pos, len)) == SuffixTree::AddStatus::Ok);
+                pos += len;
+            }
+            CHECK(st.finish_string().id == i + 1);
+            CHECK(st.get_string(i + 1) == s);
+        }
+        st.compute_counts();
+        ref.compute_counts();
+        CHECK(same_answers(st, ref));
+    }
+}
+
+static void test_add_file(std::mt19937& rng) {
+    std::string content = random_string(rng, 5000, 4);
+    write_file("stream_test.txt", content);
+
+    for (std::size_t chunk : {std::size_t{1}, std::size_t{7}, std::size_t{4096}, std::size_t{1} << 20}) {
+        SuffixTree st, ref;
+        st.add_string("abcab");
+        ref.add_string("abcab");
+        ref.add_string(content);
+
+        SuffixTree::AddResult res = st.add_file("stream_test.txt", chunk);
+        CHECK(res.status == SuffixTree::AddStatus::Ok and res.id == 2);
+        CHECK(st.get_string(2) == content);
+        st.compute_counts();
+        ref.compute_counts();
+        CHECK(same_answers(st, ref));
+    }
+    std::remove("stream_test.txt");
+}
+
+// Mismas respuestas que ref para patrones al azar, sin recalcular nada
+static void check_same_tree(SuffixTree& st, const SuffixTree& ref, std::mt19937& rng, int sigma) {
+    CHECK(st.text == ref.text);
+    CHECK(st.get_string_count() == ref.get_string_count());
+    CHECK(st.tree.arena.size() == reachable_nodes(st));
+    CHECK(same_answers(st, ref));
+    for (int q = 0; q < 20; ++q) {
+        std::string p = random_string(rng, 1 + rng() % 5, sigma);
+        CHECK(sorted_hits(st.find_all(p)) == sorted_hits(ref.find_all(p)));
+        CHECK(st.count(p) == ref.count(p));
+        CHECK(st.document_frequency(p) == ref.document_frequency(p));
+        CHECK(st.is_suffix(p) == ref.is_suffix(p));
+    }
+}
+
+static void test_add_file_errors(std::mt19937& rng) {
+    for (int iter = 0; iter < 100; ++iter) {
+        int sigma = 1 + static_cast<int>(rng() % 4);
+        SuffixTree st, ref;
+        for (int i = 0, n = 1 + static_cast<int>(rng() % 5); i < n; ++i) {
+            std::string s = random_string(rng, 1 + rng() % 30, sigma);
+            st.add_string(s);
+            ref.add_string(s);
+        }
+        if (rng() % 2 == 0) {
+            CHECK(st.remove_string(1));
+            CHECK(ref.remove_string(1));
+        }
+        if (rng() % 2 == 0) {
+            st.compute_counts();
+            ref.compute_counts();
+        }
+
+        // END_TOKEN después de varios bloques ya extendidos
+        std::size_t chunk = 1 + rng() % 16;
+        std::string content = random_string(rng, chunk * (rng() % 6) + rng() % 40, sigma) + "$" +
+                              random_string(rng, rng() % 10, sigma);
+        write_file("stream_test_bad.txt", content);
+        CHECK(st.add_file("stream_test_bad.txt", chunk).status == SuffixTree::AddStatus::ContainsEndToken);
+        CHECK(st.add_file("stream_test_missing.txt").status == SuffixTree::AddStatus::ReadFailed);
+        check_same_tree(st, ref, rng, sigma);
+
+        // El árbol sigue siendo válido para Ukkonen (suffix links)
+        std::string s = random_string(rng, 1 + rng() % 30, sigma);
+        CHECK(st.add_string(s) == ref.add_string(s));
+        st.compute_counts();
+        ref.compute_counts();
+        check_same_tree(st, ref, rng, sigma);
+    }
+    std::remove("stream_test_bad.txt");
+
+#ifndef _WIN32
+    // Un directorio se abre pero no se puede leer
+    SuffixTree st;
+    st.add_string("abcab");
+    std::string before = st.text;
+    CHECK(st.add_file(".").status == SuffixTree::AddStatus::ReadFailed);
+    CHECK(st.text == before);
+    CHECK(st.add_string("bca") == 2);
+#endif
+}
+
+#ifndef _WIN32
+// add_file desde un FIFO: seekg/tellg fallan, pero se lee igual hasta EOF
+static void test_add_file_pipe(std::mt19937& rng) {
+    const char* path = "stream_test.fifo";
+    unlink(path);
+    if (mkfifo(path, 0600) != 0) {
+        std::printf("no se pudo crear %s, se omite el test del FIFO\n", path);
+        return;
+    }
+    // Si add_file cierra antes de EOF el writer no debe morir por SIGPIPE
+    std::signal(SIGPIPE, SIG_IGN);
+    std::string content = random_string(rng, 300000, 4);
+    std::thread writer([&] {
+        write_file(path, content);
+    });
+
+    SuffixTree st;
+    SuffixTree::AddResult res = st.add_file(path, 4096);
+    writer.join();
+    unlink(path);
+
+    CHECK(res.status == SuffixTree::AddStatus::Ok and res.id == 1);
+    CHECK(st.get_string(1) == content);
+    CHECK(st.is_suffix(content.substr(content.size() - 50)));
+}
+#endif
+
+int main() {
+    std::mt19937 rng(17);
+    test_append_chunks(rng);
+    test_add_file(rng);
+    test_add_file_errors(rng);
+#ifndef _WIN32
+    test_add_file_pipe(rng);
+#endif
+    return report("test_stream");
+}
@@ -0,0 +1,153 @@
+#include "SuffixArrayIndex.h"
+#include "SuffixTree.h"
+#include "TestUtil.h"
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Tests de SuffixArrayIndex.
+ *
+ *  - sa coincide con ordenar los sufijos del texto con std::sort, y lcp
+ *    con el prefijo común calculado a mano cortado en END_TOKEN (que
+ *    cuenta si ambos sufijos llegan juntos a él). Incluye entradas muy
+ *    repetitivas ("aaaa", "abab", strings repetidos) para que SA-IS entre
+ *    en la recursión.
+ *  - is_substring, is_suffix y distinguishing_substrings responden igual
+ *    que un SuffixTree con los mismos strings.
+ *  - Sin build() las consultas dan false o vacío.
+ */
+
+using aed::structure::SuffixArrayIndex;
+using aed::structure::SuffixTree;
+using namespace aed::test;
+using Index = SuffixArrayIndex::Index;
+
+// Texto concatenado como lo guarda SuffixArrayIndex
+static std::string concat(const std::vector<std::string>& strings) {
+    std::string text;
+    for (const auto& s : strings) {
+        text += s;
+        text += SuffixArrayIndex::END_TOKEN;
+    }
+    return text;
+}
+
+static std::vector<Index> naive_sa(const std::string& text) {
+    std::vector<Index> sa(text.size());
+    std::iota(sa.begin(), sa.end(), 0);
+    std::string_view view(text);
+    std::sort(sa.begin(), sa.end(), [&](Index a, Index b) { return view.substr(a) < view.substr(b); });
+    return sa;
+}
+
+static std::vector<Index> naive_lcp(const std::string& text, const std::vector<Index>& sa) {
+    std::vector<Index> lcp(sa.size(), 0);
+    for (std::size_t i = 1; i < sa.size(); ++i) {
+        std::size_t p = sa[i - 1], q = sa[i], h = 0;
+        while (p + h < text.size() and q + h < text.size() and text[p + h] == text[q + h]
+               and text[p + h] != SuffixArrayIndex::END_TOKEN) {
+            ++h;
+        }
+        bool same_end = p + h < text.size() and q + h < text.size()
+                    and text[p + h] == SuffixArrayIndex::END_TOKEN and text[q + h] == SuffixArrayIndex::END_TOKEN;
+        lcp[i] = static_cast<Index>(h + same_end);
+    }
+    return lcp;
+}
+
+// Strings al azar; a veces periódicos o repetidos para forzar la recursión
+static std::vector<std::string> random_strings(std::mt19937& rng) {
+    int sigma = 1 + static_cast<int>(rng() % 4);
+    std::vector<std::string> strings;
+    for (int i = 0, n = 1 + static_cast<int>(rng() % 6); i < n; ++i) {
+        switch (rng() % 4) {
+        case 0: {
+            std::string unit = random_string(rng, 1 + rng() % 3, sigma);
+            std::string s;
+            for (std::size_t reps = 1 + rng() % 20; reps > 0; --reps) {
+                s += unit;
+            }
+            strings.push_back(s);
+            break;
+        }
+        case 1:
+            if (!strings.empty()) {
+                strings.push_back(strings[rng() % strings.size()]);
+                break;
+            }
+            [[fallthrough]];
+        default:
+            strings.push_back(random_string(rng, 1 + rng() % 40, sigma));
+        }
+    }
+    return strings;
+}
+
+static void test_arrays(std::mt19937& rng) {
+    for (int iter = 0; iter < 500; ++iter) {
+        std::vector<std::string> strings = random_strings(rng);
+        SuffixArrayIndex index;
+        for (const auto& s : strings) {
+            index.add_string(s);
+        }
+        index.build();
+
+        std::string text = concat(strings);
+        std::vector<Index> sa = naive_sa(text);
+        CHECK(index.suffix_array() == sa);
+        CHECK(index.lcp_array() == naive_lcp(text, sa));
+    }
+}
+
+static void test_against_tree(std::mt19937& rng) {
+    for (int iter = 0; iter < 300; ++iter) {
+        std::vector<std::string> strings = random_strings(rng);
+        SuffixArrayIndex index;
+        SuffixTree st;
+        for (const auto& s : strings) {
+            CHECK(index.add_string(s) == st.add_string(s));
+        }
+        index.build();
+
+        CHECK(index.distinguishing_substrings() == st.distinguishing_substrings());
+        for (int q = 0; q < 30; ++q) {
+            const std::string& s = strings[rng() % strings.size()];
+            std::size_t from = rng() % (s.size() + 1);
+            std::string p = rng() % 2 ? s.substr(from, rng() % 8) : random_string(rng, 1 + rng() % 5, 4);
+            if (rng() % 8 == 0) {
+                p += SuffixTree::END_TOKEN;
+            }
+            CHECK(index.is_substring(p) == st.is_substring(p));
+            CHECK(index.is_suffix(p) == st.is_suffix(p));
+        }
+    }
+}
+
+static void test_not_built() {
+    SuffixArrayIndex index;
+    CHECK(index.add_string("abcab") == 1);
+    CHECK(index.add_string("ab$") == -1);
+    CHECK(!index.is_built());
+    CHECK(!index.is_substring("ab"));
+    CHECK(!index.is_suffix("ab"));
+    CHECK(index.distinguishing_substrings().empty());
+
+    index.build();
+    CHECK(index.is_built());
+    CHECK(index.is_substring("ab"));
+    CHECK(index.is_suffix("ab"));
+    CHECK(index.add_string("bca") == 2);
+    CHECK(!index.is_substring("ab"));
+}
+
+int main() {
+    std::mt19937 rng(10);
+    test_arrays(rng);
+    test_against_tree(rng);
+    test_not_built();
+    return report("test_suffix_array");
+}
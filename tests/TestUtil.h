@@ -0,0 +1,124 @@
+#ifndef AED_TEST_UTIL
+#define AED_TEST_UTIL
+
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "SuffixTree.h"
+
+
+namespace aed::test {
+
+
+/**
+ * Cantidad de CHECK que fallaron en el ejecutable.
+ */
+inline int failures = 0;
+
+/**
+ * Código de salida del test: 0 si ningún CHECK falló.
+ */
+inline int report(const char* name) {
+    if (failures == 0) {
+        std::printf("%s: ok\n", name);
+        return 0;
+    }
+    std::printf("%s: %d fallas\n", name, failures);
+    return 1;
+}
+
+/**
+ * String pseudoaleatorio de largo n con los primeros sigma caracteres de
+ * "abcd" (alfabetos chicos para que haya muchas repeticiones).
+ */
+inline std::string random_string(std::mt19937& rng, std::size_t n, int sigma) {
+    std::string s(n, '\0');
+    for (auto& c : s) {
+        c = "abcd"[rng() % sigma];
+    }
+    return s;
+}
+
+/**
+ * Apariciones {string_id, offset} ordenadas, para comparar resultados de
+ * find_all que vienen en cualquier orden.
+ */
+using Hits = std::vector<std::pair<int, int>>;
+
+inline Hits sorted_hits(const std::vector<aed::structure::Occurrence>& occs) {
+    Hits hits;
+    hits.reserve(occs.size());
+    for (const auto& o : occs) {
+        hits.push_back({o.string_id, o.offset});
+    }
+    std::sort(hits.begin(), hits.end());
+    return hits;
+}
+
+/**
+ * Referencia por fuerza bruta: apariciones de pattern (no vacío) en
+ * strings, con string_id = índice + 1. Un string quitado se representa
+ * vacío.
+ */
+inline Hits naive_find_all(const std::vector<std::string>& strings, std::string_view pattern) {
+    Hits hits;
+    for (std::size_t i = 0; i < strings.size(); ++i) {
+        for (std::size_t p = strings[i].find(pattern); p != std::string::npos; p = strings[i].find(pattern, p + 1)) {
+            hits.push_back({static_cast<int>(i) + 1, static_cast<int>(p)});
+        }
+    }
+    return hits;
+}
+
+/**
+ * Nodos alcanzables desde la raíz (sin contarla); con la arena al día
+ * coincide con tree.arena.size().
+ */
+inline std::size_t reachable_nodes(aed::structure::SuffixTree& st) {
+    std::size_t nodes = 0;
+    std::vector<const aed::structure::SuffixTree::Node*> stack{&st.tree.root};
+    while (!stack.empty()) {
+        const aed::structure::SuffixTree::Node* n = stack.back();
+        stack.pop_back();
+        nodes += n != &st.tree.root;
+        for (auto&& e : n->children()) {
+            stack.push_back(e.second.tgt);
+        }
+    }
+    return nodes;
+}
+
+/**
+ * Cantidad de strings distintos en hits (ordenados).
+ */
+inline int distinct_strings(const Hits& hits) {
+    int n = 0;
+    for (std::size_t i = 0; i < hits.size(); ++i) {
+        n += (i == 0 or hits[i].first != hits[i - 1].first);
+    }
+    return n;
+}
+
+
+} // namespace aed::test
+
+
+/**
+ * CHECK - Cuenta y reporta la falla sin cortar el test, así un mismo
+ * ejecutable muestra todas las diferencias.
+ */
+#define CHECK(cond)                                                          \
+    do {                                                                     \
+        if (!(cond)) {                                                       \
+            ++aed::test::failures;                                           \
+            std::printf("%s:%d: falló CHECK(%s)\n", __FILE__, __LINE__, #cond); \
+        }                                                                    \
+    } while (0)
+
+
+#endif // AED_TEST_UTIL